@@ -28,6 +28,16 @@
 #include "fxchat_errhand.h"
 #include "fxchat_script.h"
 #include "fxchat_vm.h"
+#include "fxchat_cache.h"
+#include "fxchat_loader.h"
+#include "fxchat_mem.h"
+#include "fxchat_gc.h"
+#include "fxchat_timer.h"
+#include "fxchat_output.h"
+#include "fxchat_context.h"
+
+#include <stdlib.h>
+#include <string.h>
 
 #include "xchat-plugin.h"
 
@@ -61,9 +71,13 @@
 //
 
 static void Cmd_FalconList();
-static void Cmd_FalconLoad( const Falcon::String &fname, char **params );
+static void Cmd_FalconLoad( const Falcon::String &fname, char **params, bool bShared = false, long heapLimit = 0 );
+static void Cmd_FalconMem( const Falcon::String &fname );
+static void Cmd_FalconGC( char **params );
+static void Cmd_FalconBudget( const Falcon::String &fname, const char *msecs );
 static void Cmd_FalconUnload( const Falcon::String &fname );
 static void Cmd_FalconReload( const Falcon::String &fname, char **params );
+static void Cmd_FalconHotReload( const Falcon::String &fname );
 static void Cmd_FalconReset( const Falcon::String &fname  );
 static void Cmd_FalconAbout();
 static void Cmd_FalconHelp( char **params, char *rest );
@@ -76,10 +90,14 @@ static int Cmd_Unload(char *word[], char *word_eol[], void *userdata);
 // Module wide define
 //
 static const char usage[] =
-   PNAME ": Usage: /FALCON LOAD <filename>\n"
+   PNAME ": Usage: /FALCON LOAD [-shared] [-heap <KB>] <filename>\n"
    PNAME ":                UNLOAD <filename|name>\n"
    PNAME ":                RELOAD <filename|name>\n"
+   PNAME ":                HOTRELOAD <name>\n"
    PNAME ":                LIST\n"
+   PNAME ":                MEM [name]\n"
+   PNAME ":                GC [BUDGET <msecs>]\n"
+   PNAME ":                BUDGET <name> [<msecs>]\n"
    PNAME ":                HELP\n"
    PNAME ":                ABOUT\n\n";
 
@@ -124,25 +142,71 @@ static ScriptDataList *s_modules;
 // Utilities & generic functions
 //
 
-void xchat_print_falcon( const Falcon::String &str )
+// utf-8 conversion buffer, reused by all the prints.
+static __thread char *s_encBuffer = 0;
+static __thread Falcon::uint32 s_encSize = 0;
+
+// Makes room for a number of characters, plus the terminator.
+static char *internal_enc_buffer( Falcon::uint32 chars )
 {
-   // transform in a utf8 string
-   // try to do it the fast way using stack memory.
-   if ( str.size() < 2048 )
+   Falcon::uint32 size = chars * 4 + 1; // max utf8 size
+   if ( size > s_encSize )
    {
-      char buffer[2048];
-      if( str.toCString( buffer, 2048 ) ) {
-         xchat_print( ph, buffer );
-         return;
-      }
+      s_encSize = size < 2048 ? 2048 : size + size / 2;
+      s_encBuffer = (char *) realloc( s_encBuffer, s_encSize );
    }
 
-   // it didn't work; do it the right way.
-   int maxlen = str.length() * 4 + 4; // max utf8 size
-   char *buffer = new char[ maxlen ];
-   str.toCString( buffer, maxlen );
+   return s_encBuffer;
+}
+
+static void internal_free_enc_buffer()
+{
+   free( s_encBuffer );
+   s_encBuffer = 0;
+   s_encSize = 0;
+}
+
+void xchat_print_falcon( const Falcon::String &str )
+{
+   // after what the scripts have printed so far.
+   FlushOutput();
+
+   char *buffer = internal_enc_buffer( str.length() );
+   str.toCString( buffer, s_encSize );
    xchat_print( ph, buffer );
-   delete[] buffer;
+}
+
+void xchat_print_falcon( const Falcon::String &prefix, const Falcon::String &body )
+{
+   // encode both in the buffer, one after the other.
+   char *buffer = internal_enc_buffer( prefix.length() + body.length() );
+   prefix.toCString( buffer, s_encSize );
+   Falcon::uint32 plen = strlen( buffer );
+   body.toCString( buffer + plen, s_encSize - plen );
+   Falcon::uint32 len = plen + strlen( buffer + plen );
+
+   // a single line is already in place.
+   const char *eol = (const char *) memchr( buffer + plen, '\n', len - plen );
+   if ( eol == 0 || eol == buffer + len - 1 )
+   {
+      FlushOutput();
+      xchat_print( ph, buffer );
+      return;
+   }
+
+   // otherwise, print all the lines at once.
+   const char *pos = buffer + plen;
+   const char *end = buffer + len;
+   while( pos < end )
+   {
+      eol = (const char *) memchr( pos, '\n', end - pos );
+      const char *next = eol != 0 ? eol + 1 : end;
+      QueueOutput( buffer, plen );
+      QueueOutput( pos, next - pos );
+      pos = next;
+   }
+
+   FlushOutput();
 }
 
 //==============================================
@@ -161,7 +225,41 @@ static int Cmd_Falcon(char *word[], char *word_eol[], void *userdata)
    }
    else if ( cmd.compareIgnoreCase( "LOAD" ) == 0 && word[3][0] != 0 )
    {
-      Cmd_FalconLoad( word[3], word + 4 );
+      int pos = 3;
+      bool bShared = false;
+      long heapLimit = 0;
+
+      while( word[pos][0] == '-' )
+      {
+         Falcon::String opt( word[pos] );
+         if ( opt.compareIgnoreCase( "-shared" ) == 0 )
+            bShared = true;
+         else if ( opt.compareIgnoreCase( "-heap" ) == 0 && atol( word[pos+1] ) > 0 )
+            heapLimit = atol( word[++pos] ) * 1024;
+         else
+            break;
+         ++pos;
+      }
+
+      if ( word[pos][0] != 0 )
+      {
+         Cmd_FalconLoad( word[pos], word + pos + 1, bShared, heapLimit );
+         bOk = true;
+      }
+   }
+   else if ( cmd.compareIgnoreCase( "MEM" ) == 0 )
+   {
+      Cmd_FalconMem( word[3] );
+      bOk = true;
+   }
+   else if ( cmd.compareIgnoreCase( "GC" ) == 0 )
+   {
+      Cmd_FalconGC( word + 3 );
+      bOk = true;
+   }
+   else if ( cmd.compareIgnoreCase( "BUDGET" ) == 0 && word[3][0] != 0 )
+   {
+      Cmd_FalconBudget( word[3], word[4] );
       bOk = true;
    }
    else if ( cmd.compareIgnoreCase( "UNLOAD" ) == 0 && word[3][0] != 0 )
@@ -174,6 +272,11 @@ static int Cmd_Falcon(char *word[], char *word_eol[], void *userdata)
       Cmd_FalconReload( word[3], word + 4 );
       bOk = true;
    }
+   else if ( cmd.compareIgnoreCase( "HOTRELOAD" ) == 0 && word[3][0] != 0 )
+   {
+      Cmd_FalconHotReload( word[3] );
+      bOk = true;
+   }
    else if ( cmd.compareIgnoreCase( "RESET" ) == 0 && word[3][0] != 0 )
    {
       Cmd_FalconReset( word[3] );
@@ -225,33 +328,40 @@ static int Cmd_Unload(char *word[], char *word_eol[], void *userdata)
 static void Cmd_FalconList()
 {
    s_modules->list();
+   ListPendingLoads();
+}
+
+static void Cmd_FalconLoad( const Falcon::String &fname, char **args, bool bShared, long heapLimit )
+{
+   // the script is compiled in background, and installed when ready.
+   LoadScriptAsync( fname, args, bShared, heapLimit );
 }
 
-static void Cmd_FalconLoad( const Falcon::String &fname, char **args )
+void InstallModule( Falcon::Module *mod, Falcon::Runtime *rt, char **args, bool bShared, long heapLimit )
 {
-   // let's try to load that module.
+   // let's try to install that module.
    ScriptData *xmodule = 0;
    bool delmod = true; // delete the module in case of problems.
-   
+
    try
    {
-      Falcon::Module *mod = s_loader->loadSource( fname );
-      // great; the module has been loaded. Now, reslove all the references.
-      // to do that properly, we need an ardmed runtime.
-      Falcon::Runtime r( s_loader );
-      r.addModule( mod );
-
       // great, now we can create an instance of the VM, which we have in XChatModule
-      xmodule = new ScriptData( mod, args );
+      xmodule = new ScriptData( mod, args, bShared );
 
-      // we can abandon now our reference to the module. Xmodule has one.
-      mod->decref();
+      // the limit is on the VM; the shared one belongs to many scripts.
+      if ( heapLimit != 0 )
+      {
+         if ( bShared )
+            xchat_print_falcon( PNAME ": Heap limit ignored for shared module " + xmodule->name() + "\n" );
+         else
+            xmodule->m_vm->memAccount()->limit( heapLimit );
+      }
 
       // insert the loaded module(s) in the VM.
-      xmodule->m_vm->link( &r );
+      xmodule->link( rt );
 
       // ready the run symbol
-      if( xmodule->m_vm->mainModule()->module()->findGlobalSymbol( "__main__" ) == 0 )
+      if( mod->findGlobalSymbol( "__main__" ) == 0 )
       {
          // not a valid module? -- kill it
          delete xmodule;
@@ -261,7 +371,7 @@ static void Cmd_FalconLoad( const Falcon::String &fname, char **args )
       // we are in; save the module and run the script.
       s_modules->append( xmodule );
       delmod = false;
-      
+
       Falcon::AutoCString modName( mod->name() );
       xchat_printf( the_plugin, PNAME ": Loaded module %s", modName.c_str() );
 
@@ -304,13 +414,131 @@ static void Cmd_FalconReload( const Falcon::String &fname, char **params )
 
    xchat_print_falcon( PNAME ": Reloading module " + fname + "\n" );
    Falcon::String path = mod->m_module->path();
+   bool bShared = mod->m_vm->isShared();
+   long heapLimit = mod->m_vm->memAccount()->limit();
    s_modules->remove( mod );
    delete mod;
 
-   Cmd_FalconLoad( path, params );
-   xchat_print_falcon( PNAME ": Reloading complete\n" );
+   // the new copy reports when it's loaded.
+   Cmd_FalconLoad( path, params, bShared, heapLimit );
 }
 
+static void Cmd_FalconMem( const Falcon::String &fname )
+{
+   if ( fname == "" )
+   {
+      const MemAccount *engine = EngineMemAccount();
+      xchat_printf( ph, PNAME ": Memory outside the scripts: %ld KB in %ld blocks (peak %ld KB)\n",
+         engine->bytes() / 1024, engine->blocks(), engine->peak() / 1024 );
+      return;
+   }
+
+   ScriptData *mod = s_modules->find( fname );
+   if( mod == 0 )
+   {
+      xchat_print_falcon( PNAME ": Module " + fname + " not found\n" );
+      return;
+   }
+
+   const MemAccount *acc = mod->m_vm->memAccount();
+   xchat_print_falcon( PNAME ": Memory of module " + fname +
+      ( mod->m_vm->isShared() ? " (shared VM)\n" : "\n" ) );
+   xchat_printf( ph, PNAME ":   heap: %ld KB (peak %ld KB)\n", acc->bytes() / 1024, acc->peak() / 1024 );
+   if ( acc->limit() != 0 )
+      xchat_printf( ph, PNAME ":   limit: %ld KB\n", acc->limit() / 1024 );
+   xchat_printf( ph, PNAME ":   live blocks: %ld\n", acc->blocks() );
+   xchat_printf( ph, PNAME ":   collected blocks: %ld\n", acc->collected() );
+   xchat_printf( ph, PNAME ":   collections: %ld, pause %ld ms total, %ld ms max\n",
+      acc->gcCycles(), acc->gcPause() / 1000, acc->gcMaxPause() / 1000 );
+}
+
+static void Cmd_FalconGC( char **params )
+{
+   if ( params[0][0] != 0 )
+   {
+      Falcon::String sub( params[0] );
+      if ( sub.compareIgnoreCase( "BUDGET" ) != 0 || atoi( params[1] ) <= 0 )
+      {
+         xchat_print( ph, usage );
+         return;
+      }
+
+      GCBudget( atoi( params[1] ) );
+   }
+
+   PrintGCStats();
+}
+
+static void Cmd_FalconBudget( const Falcon::String &fname, const char *msecs )
+{
+   ScriptData *mod = s_modules->find( fname );
+   if( mod == 0 )
+   {
+      xchat_print_falcon( PNAME ": Module " + fname + " not found\n" );
+      return;
+   }
+
+   // 0 removes the budget.
+   if ( msecs[0] != 0 )
+   {
+      if ( atoi( msecs ) < 0 || ( atoi( msecs ) == 0 && msecs[0] != '0' ) )
+      {
+         xchat_print( ph, usage );
+         return;
+      }
+      mod->budget( atoi( msecs ) );
+   }
+
+   Falcon::AutoCString name( mod->name() );
+   if ( mod->budget() == 0 )
+      xchat_printf( ph, PNAME ": Module %s has no execution budget\n", name.c_str() );
+   else
+      xchat_printf( ph, PNAME ": Module %s: budget %d ms per callback\n", name.c_str(), mod->budget() );
+   xchat_printf( ph, PNAME ":   exceeded %ld times, preempted %ld times\n",
+      mod->overruns(), mod->preemptions() );
+}
+
+static void Cmd_FalconHotReload( const Falcon::String &fname )
+{
+   ScriptData *mod = s_modules->find( fname );
+
+   if( mod == 0 )
+   {
+      xchat_print_falcon( PNAME ": Module " + fname + " not found\n" );
+      return;
+   }
+
+   xchat_print_falcon( PNAME ": Hot reloading module " + fname + "\n" );
+   ReloadScriptAsync( mod->m_module->path(), mod->name() );
+}
+
+void HotReloadModule( const Falcon::String &name, Falcon::Module *mod, Falcon::Runtime *rt )
+{
+   // the script may have gone while we were compiling.
+   ScriptData *xmodule = s_modules->find( name );
+   if( xmodule == 0 )
+   {
+      xchat_print_falcon( PNAME ": Module " + name + " not found\n" );
+      return;
+   }
+
+   // a suspended main routine would resume in the old code.
+   if( xmodule->isSleeping() )
+   {
+      xchat_print_falcon( PNAME ": Module " + name + " is running; use RELOAD.\n" );
+      return;
+   }
+
+   try
+   {
+      xmodule->hotReload( mod, rt );
+      xchat_print_falcon( PNAME ": Hot reloaded module " + name + "\n" );
+   }
+   catch( Falcon::Error* err )
+   {
+      XChatErrHand::handleError( err, xmodule );
+   }
+}
 
 static void Cmd_FalconReset( const Falcon::String &fname  )
 {
@@ -358,43 +586,40 @@ static void Cmd_FalconHelp( char **param, char *rest )
 
    if ( cmd.compareIgnoreCase( "EVENTS" ) == 0 )
    {
-      ParamMap::const_iterator paramIter = s_PMevent.begin();
       xchat_print_falcon( PNAME ": known events:\n");
-      while( paramIter != s_PMevent.end() )
+      for( int i = 0; i < EventCount(); i++ )
       {
-         xchat_print_falcon( PNAME ":   " + paramIter->first );
-         ++paramIter;
+         xchat_print_falcon( Falcon::String( PNAME ":   " ) + EventAt( i ).m_name );
       }
       xchat_print_falcon( PNAME ": for a description of the data filled in event callbacks, use /FALCON HELP EVENT <eventName>\n\n");
    }
    else if ( cmd.compareIgnoreCase( "MESSAGES" ) == 0 )
    {
-      ParamMap::const_iterator paramIter = s_PMsrvmsg.begin();
       xchat_print_falcon( PNAME ": known server messages:\n");
-      while( paramIter != s_PMsrvmsg.end() )
+      for( int i = 0; i < SrvMsgCount(); i++ )
       {
-         xchat_print_falcon( PNAME ":   " + paramIter->first );
-         ++paramIter;
+         xchat_print_falcon( Falcon::String( PNAME ":   " ) + SrvMsgAt( i ).m_name );
       }
       xchat_print_falcon( PNAME ": for a description of the data filled in server message callbacks, use /FALCON HELP MESSAGE <message>\n\n");
    }
    else if ( cmd.compareIgnoreCase( "EVENT" ) == 0 )
    {
       // try to search the described event.
-      ParamMap::const_iterator paramIter = s_PMevent.find( rest );
-      if ( paramIter == s_PMevent.end() )
+      Falcon::String event( rest );
+      const ParamDescList *params = FindEventParams( event );
+      if ( params == 0 )
       {
          xchat_print_falcon( PNAME ": Sorry, event not knwon\n" );
       }
       else {
-         xchat_print_falcon( PNAME ": Print event \"" + paramIter->first + "\" parameters:\n");
-         if ( paramIter->second.empty() )
+         xchat_print_falcon( PNAME ": Print event \"" + event + "\" parameters:\n");
+         if ( params->empty() )
          {
             xchat_print_falcon( PNAME ":   None.\n" );
          }
          else {
-            ParamDescList::const_iterator liter = paramIter->second.begin();
-            while( liter != paramIter->second.end() )
+            ParamDescList::const_iterator liter = params->begin();
+            while( liter != params->end() )
             {
                const ParamDesc &pd = *liter;
                xchat_print_falcon( Falcon::String( PNAME ":   * " ) + pd.m_param + " = " + pd.m_desc );
@@ -406,21 +631,22 @@ static void Cmd_FalconHelp( char **param, char *rest )
    else if ( cmd.compareIgnoreCase( "MESSAGE" ) == 0 )
    {
       // try to search the described server message.
-      ParamMap::const_iterator paramIter = s_PMsrvmsg.find( rest );
-      if( paramIter == s_PMsrvmsg.end() )
+      Falcon::String msg( rest );
+      const ParamDescList *params = FindSrvMsgParams( msg );
+      if( params == 0 )
       {
          xchat_print_falcon( PNAME ": Sorry, help server message not known\n" );
       }
       else {
-         xchat_print_falcon( PNAME ": Server message \"" + paramIter->first + "\" parameters:\n");
+         xchat_print_falcon( PNAME ": Server message \"" + msg + "\" parameters:\n");
 
          // this parameters are common for all the server messages.
          xchat_print_falcon( Falcon::String( PNAME ":   * nick = The nickname sent with this message" ) );
          xchat_print_falcon( Falcon::String( PNAME ":   * nick:user = The user name part of this nick." ) );
          xchat_print_falcon( Falcon::String( PNAME ":   * nick:net = The network part of this nick." ) );
 
-         ParamDescList::const_iterator liter = paramIter->second.begin();
-         while( liter != paramIter->second.end() )
+         ParamDescList::const_iterator liter = params->begin();
+         while( liter != params->end() )
          {
             const ParamDesc &pd = *liter;
             xchat_print_falcon( Falcon::String( PNAME ":   * " ) + pd.m_param + " = " + pd.m_desc );
@@ -465,6 +691,8 @@ int xchat_plugin_init(xchat_plugin *plugin_handle,
                      char **plugin_version,
                      char *arg)
 {
+   // every block of the engine must carry the accounting header.
+   InitMemAccounting();
    Falcon::Engine::Init();
    
    /* we need to save this for use with any xchat_* functions */
@@ -501,6 +729,19 @@ int xchat_plugin_init(xchat_plugin *plugin_handle,
    // create the loader and set the error handler to xchat.
    s_loader = new Falcon::ModuleLoader( envpath );
 
+   // scripts are compiled by background workers with their own loaders.
+   if ( ! InitAsyncLoader( envpath ) )
+      xchat_print(ph, PNAME ": Warning: can't start the background loader; scripts will be compiled in place.\n" );
+
+   // compiled scripts are cached under the xchat configuration directory.
+   Falcon::String xchatdir;
+   const char *cxchatdir = xchat_get_info( ph, "xchatdir" );
+   if ( cxchatdir != 0 )
+   {
+      xchatdir.fromUTF8( cxchatdir );
+      InitModuleCache( xchatdir + "/falcon_cache" );
+   }
+
    // Create also an instance of the Falcon Core module
    s_modCore = Falcon::core_module_init();
 
@@ -510,6 +751,15 @@ int xchat_plugin_init(xchat_plugin *plugin_handle,
    // and finally, the list where we'll store loaded modules
    s_modules = new ScriptDataList;
 
+   // the first script will find its VM ready.
+   XChatVM::preparePrelinked();
+
+   // collections are run when xchat is idle.
+   InitGCScheduler();
+
+   // the closed contexts are removed from the scripts' caches.
+   InitContextCache();
+
    // we're armed and ready for combat. Just add xchat hooks:
 
    xchat_hook_command(ph, "FALCON", XCHAT_PRI_NORM, Cmd_Falcon, usage, 0);
@@ -517,11 +767,15 @@ int xchat_plugin_init(xchat_plugin *plugin_handle,
    xchat_hook_command(ph, "LOAD", XCHAT_PRI_NORM, Cmd_Load, 0, 0);
    xchat_hook_command(ph, "UNLOAD", XCHAT_PRI_NORM, Cmd_Load, 0, 0);
 
-   LoadEventParamMap();
-   LoadSrvMsgParamMap();
-
    xchat_print(ph, PNAME ": Falcon interface succesfully loaded.\n" );
 
+   // load the scripts in the xchat directory, as the other script plugins do.
+   if ( cxchatdir != 0 )
+   {
+      AutoloadScripts( xchatdir );
+      AutoloadScripts( xchatdir + "/falcon_shared", true );
+   }
+
    return 1;
 }
 
@@ -534,8 +788,14 @@ int xchat_plugin_deinit()
 
    //TODO: Running scripts
 
+   // scripts still being compiled are abandoned.
+   ShutdownAsyncLoader();
+   ShutdownGCScheduler();
+
    // destroy all the scripts
    delete s_modules;
+   XChatVM::dropPrelinked();
+   ShutdownTimers();
 
    // delete the standard modules
    s_modCore->decref();
@@ -544,6 +804,9 @@ int xchat_plugin_deinit()
    delete s_loader;
 
    Falcon::Engine::Shutdown();
+   ShutdownMemAccounting();
+   ShutdownOutput();
+   internal_free_enc_buffer();
 
    xchat_print(ph, PNAME ": Falcon interface unloaded.\n");
    return 1;
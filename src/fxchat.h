@@ -25,14 +25,22 @@
 
 #include <falcon/engine.h>
 #include "xchat-plugin.h"
+#include "fxchat_utf8.h"
 
 #define PNAME "fxchat"
 #define PDESC "Falcon xchat interface";
 
 void xchat_print_falcon( const Falcon::String &str );
+// Prints the body with the prefix in front of each of its lines.
+void xchat_print_falcon( const Falcon::String &prefix, const Falcon::String &body );
+
 
 class ScriptData;
 void UnloadModule( ScriptData *mod );
+// Creates the VM of a compiled script, links it and runs it.
+void InstallModule( Falcon::Module *mod, Falcon::Runtime *rt, char **args, bool bShared, long heapLimit );
+// Links a new version of a compiled script in its running VM.
+void HotReloadModule( const Falcon::String &name, Falcon::Module *mod, Falcon::Runtime *rt );
 
 // The plugin handle pointer, used in the various modules.
 extern xchat_plugin *the_plugin;
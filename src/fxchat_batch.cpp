@@ -0,0 +1,119 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_batch.cpp
+
+   Falcon script Xchat plugin
+   Batched delivery of print and server events
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:29:50
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Batched delivery of print and server events.
+*/
+
+#include <falcon/engine.h>
+
+#include "fxchat.h"
+#include "fxchat_batch.h"
+#include "fxchat_lazyevt.h"
+#include "fxchat_hook.h"
+#include "fxchat_script.h"
+
+extern "C" int batch_timer_cb( void *user_data )
+{
+   EventBatch *batch = (EventBatch *) user_data;
+   batch->timeout();
+
+   // the timer is re-armed by the next event.
+   return 0;
+}
+
+
+EventBatch::EventBatch( XChatHook *owner, int size, int msecs ):
+   m_owner( owner ),
+   m_size( size ),
+   m_head( 0 ),
+   m_count( 0 ),
+   m_msecs( msecs ),
+   m_timer( batch_timer_cb, this )
+{
+   m_ring = new LazyEvent*[ m_size ];
+}
+
+EventBatch::~EventBatch()
+{
+   // undelivered events are lost with the hook.
+   for( int i = 0; i < m_count; i++ )
+      delete m_ring[ (m_head + i) % m_size ];
+
+   delete[] m_ring;
+}
+
+void EventBatch::push( LazyEvent *evt )
+{
+   // the ring is kept full while the script is suspended;
+   // the oldest event makes room for the new one.
+   if ( m_count == m_size )
+   {
+      delete m_ring[ m_head ];
+      m_head = (m_head + 1) % m_size;
+      --m_count;
+   }
+
+   m_ring[ (m_head + m_count) % m_size ] = evt;
+   ++m_count;
+
+   if ( m_count == m_size )
+   {
+      flush();
+      // don't use this anymore
+      return;
+   }
+
+   if ( ! m_timer.armed() )
+      m_timer.start( m_msecs );
+}
+
+void EventBatch::timeout()
+{
+   // the wheel has already disarmed the timer.
+   flush();
+}
+
+void EventBatch::flush()
+{
+   m_timer.cancel();
+
+   if ( m_count == 0 )
+      return;
+
+   // a suspended script can't be called; try again later.
+   if ( m_owner->owner()->isSleeping() )
+   {
+      m_timer.start( m_msecs );
+      return;
+   }
+
+   // empty the ring before calling the script, which may
+   // generate new events or destroy the hook.
+   int count = m_count;
+   LazyEvent **events = new LazyEvent*[ count ];
+   for( int i = 0; i < count; i++ )
+      events[i] = m_ring[ (m_head + i) % m_size ];
+
+   m_head = (m_head + count) % m_size;
+   m_count = 0;
+
+   DeliverBatch( m_owner, events, count );
+   delete[] events;
+}
+
+/* end of fxchat_batch.cpp */
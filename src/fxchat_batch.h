@@ -0,0 +1,74 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_batch.h
+
+   Falcon script Xchat plugin
+   Batched delivery of print and server events
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:29:50
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Batched delivery of print and server events.
+*/
+
+#ifndef fxchat_batch_H
+#define fxchat_batch_H
+
+#include "xchat-plugin.h"
+#include "fxchat_timer.h"
+
+class XChatHook;
+class LazyEvent;
+
+// Native queue of events waiting to be delivered to a script in a
+// single call. Events are stored as detached LazyEvent carriers, so
+// that no VM item is created until the batch is delivered.
+// The batch is delivered when it's full or when the timer expires.
+class EventBatch
+{
+   XChatHook *m_owner;
+
+   // ring buffer of queued events
+   LazyEvent **m_ring;
+   int m_size;
+   int m_head;
+   int m_count;
+
+   int m_msecs;
+   // armed only while there are queued events
+   TimerEntry m_timer;
+
+public:
+   EventBatch( XChatHook *owner, int size, int msecs );
+   ~EventBatch();
+
+   // Takes ownership of a detached event.
+   void push( LazyEvent *evt );
+
+   // Delivers the queued events, if any.
+   // The batch may be destroyed by the script during the delivery.
+   void flush();
+
+   // Called by the timer wheel.
+   void timeout();
+
+   int size() const { return m_size; }
+   int msecs() const { return m_msecs; }
+   int count() const { return m_count; }
+};
+
+// Delivers an array of events to the script hook, taking ownership of them;
+// implemented along with the other callbacks.
+void DeliverBatch( XChatHook *hook, LazyEvent **events, int count );
+
+#endif
+
+/* end of fxchat_batch.h */
@@ -0,0 +1,216 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_cache.cpp
+
+   Falcon script Xchat plugin
+   On-disk cache of compiled scripts
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:42:58
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   On-disk cache of compiled scripts.
+*/
+
+#include <falcon/engine.h>
+#include <falcon/fstream.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fxchat_cache.h"
+
+#define CACHE_MAGIC "FXC2"
+
+// Header of the cache files; followed by the source path and the module.
+// It's compared as a whole, so it has no implicit padding.
+struct CacheHeader
+{
+   char m_magic[4];
+   Falcon::uint32 m_engine;
+   Falcon::int64 m_mtime;
+   Falcon::int64 m_mtimeNsec;
+   Falcon::int64 m_ctime;
+   Falcon::int64 m_ctimeNsec;
+   Falcon::uint64 m_inode;
+   Falcon::int64 m_size;
+   Falcon::uint32 m_pathLen;
+   Falcon::uint32 m_reserved;
+};
+
+static Falcon::String s_cacheDir;
+
+void InitModuleCache( const Falcon::String &dir )
+{
+   s_cacheDir = dir;
+   s_cacheDir.bufferize();
+
+   if ( s_cacheDir.size() != 0 )
+   {
+      Falcon::AutoCString cdir( s_cacheDir );
+      // it's ok if it exists already.
+      mkdir( cdir.c_str(), 0700 );
+   }
+}
+
+// Fills the key of the source; returns false if the source can't be found.
+static bool internal_key( const Falcon::String &fname, char *absPath, CacheHeader &hdr )
+{
+   Falcon::AutoCString cname( fname );
+   if ( realpath( cname.c_str(), absPath ) == 0 )
+      return false;
+
+   struct stat st;
+   if ( stat( absPath, &st ) != 0 )
+      return false;
+
+   // the header is compared with memcmp; no byte can be left random.
+   memset( &hdr, 0, sizeof( hdr ) );
+   memcpy( hdr.m_magic, CACHE_MAGIC, 4 );
+   hdr.m_engine = FALCON_VERSION_NUM;
+   // a script saved twice in the same second must not look unchanged.
+   hdr.m_mtime = (Falcon::int64) st.st_mtim.tv_sec;
+   hdr.m_mtimeNsec = (Falcon::int64) st.st_mtim.tv_nsec;
+   hdr.m_ctime = (Falcon::int64) st.st_ctim.tv_sec;
+   hdr.m_ctimeNsec = (Falcon::int64) st.st_ctim.tv_nsec;
+   hdr.m_inode = (Falcon::uint64) st.st_ino;
+   hdr.m_size = (Falcon::int64) st.st_size;
+   hdr.m_pathLen = strlen( absPath );
+   return true;
+}
+
+// Cache file name: FNV-1a 64 of the absolute path.
+static Falcon::String internal_cache_file( const char *absPath )
+{
+   Falcon::uint64 h = 14695981039346656037ULL;
+   for( const char *p = absPath; *p != '\0'; ++p )
+   {
+      h ^= (unsigned char) *p;
+      h *= 1099511628211ULL;
+   }
+
+   char name[32];
+   sprintf( name, "/%016llx.fam", (unsigned long long) h );
+   return s_cacheDir + name;
+}
+
+Falcon::Module *LoadCachedModule( Falcon::ModuleLoader *loader, const Falcon::String &fname )
+{
+   if ( s_cacheDir.size() == 0 )
+      return 0;
+
+   char absPath[PATH_MAX];
+   CacheHeader key;
+   if ( ! internal_key( fname, absPath, key ) )
+      return 0;
+
+   Falcon::FileStream in;
+   if ( ! in.open( internal_cache_file( absPath ), Falcon::BaseFileStream::e_omReadOnly ) )
+      return 0;
+
+   CacheHeader hdr;
+   char path[PATH_MAX];
+   if ( in.read( &hdr, sizeof( hdr ) ) != (Falcon::int32) sizeof( hdr ) ||
+         memcmp( &hdr, &key, sizeof( hdr ) ) != 0 ||
+         in.read( path, hdr.m_pathLen ) != (Falcon::int32) hdr.m_pathLen ||
+         memcmp( path, absPath, hdr.m_pathLen ) != 0 )
+   {
+      // stale or from another script with the same hash.
+      in.close();
+      return 0;
+   }
+
+   Falcon::Module *mod = 0;
+   try
+   {
+      mod = loader->loadModule( &in );
+   }
+   catch( Falcon::Error *err )
+   {
+      // a damaged cache is just a miss.
+      err->decref();
+      mod = 0;
+   }
+   in.close();
+
+   if ( mod != 0 )
+   {
+      // give the module the identity it would have had when compiled.
+      Falcon::String name( fname );
+      Falcon::uint32 pos = name.rfind( "/" );
+      if ( pos != Falcon::String::npos )
+         name = name.subString( pos + 1 );
+      pos = name.rfind( "." );
+      if ( pos != Falcon::String::npos && pos > 0 )
+         name = name.subString( 0, pos );
+
+      mod->name( name );
+      mod->path( fname );
+   }
+
+   return mod;
+}
+
+void StoreCachedModule( const Falcon::Module *mod, const Falcon::String &fname )
+{
+   if ( s_cacheDir.size() == 0 )
+      return;
+
+   char absPath[PATH_MAX];
+   CacheHeader hdr;
+   if ( ! internal_key( fname, absPath, hdr ) )
+      return;
+
+   Falcon::String target = internal_cache_file( absPath );
+   // the loader threads may store the same script at once.
+   static int s_tempCount = 0;
+   char suffix[48];
+   sprintf( suffix, ".%d.%d.tmp", (int) getpid(), __sync_fetch_and_add( &s_tempCount, 1 ) );
+   Falcon::String temp = target + suffix;
+
+   Falcon::FileStream out;
+   if ( ! out.create( temp, (Falcon::BaseFileStream::t_attributes)
+         ( Falcon::BaseFileStream::e_aUserRead | Falcon::BaseFileStream::e_aUserWrite ) ) )
+      return;
+
+   bool bOk = out.write( &hdr, sizeof( hdr ) ) == (Falcon::int32) sizeof( hdr ) &&
+         out.write( absPath, hdr.m_pathLen ) == (Falcon::int32) hdr.m_pathLen;
+
+   if ( bOk )
+   {
+      try
+      {
+         bOk = mod->save( &out );
+      }
+      catch( Falcon::Error *err )
+      {
+         err->decref();
+         bOk = false;
+      }
+   }
+   out.close();
+
+   Falcon::AutoCString ctemp( temp );
+   if ( bOk )
+   {
+      Falcon::AutoCString ctarget( target );
+      if ( rename( ctemp.c_str(), ctarget.c_str() ) == 0 )
+         return;
+   }
+
+   unlink( ctemp.c_str() );
+}
+
+/* end of fxchat_cache.cpp */
@@ -0,0 +1,47 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_cache.h
+
+   Falcon script Xchat plugin
+   On-disk cache of compiled scripts
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:42:58
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   On-disk cache of compiled scripts.
+*/
+
+#ifndef fxchat_cache_H
+#define fxchat_cache_H
+
+#include <falcon/engine.h>
+
+// Compiled modules are stored as .fam files in the cache directory,
+// one per script, named after a hash of the absolute path of the
+// source. Each file starts with a header recording the absolute path,
+// the modification time and size of the source and the engine version;
+// a cached module is used only if all of them match.
+
+// Sets the cache directory, creating it if needed; an empty
+// directory disables the cache.
+void InitModuleCache( const Falcon::String &dir );
+
+// Loads the module from the cache, if it's up to date; returns 0 otherwise.
+Falcon::Module *LoadCachedModule( Falcon::ModuleLoader *loader, const Falcon::String &fname );
+
+// Stores a freshly compiled module. The file is written under a temporary
+// name and then renamed, so that the cache never has a partial module.
+// Failures are not reported: the script will just be compiled again.
+void StoreCachedModule( const Falcon::Module *mod, const Falcon::String &fname );
+
+#endif
+
+/* end of fxchat_cache.h */
@@ -0,0 +1,207 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_context.cpp
+
+   Falcon script Xchat plugin
+   Current context tracking and context objects
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 15:01:51
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Current context tracking and context objects.
+*/
+
+#include <falcon/engine.h>
+
+#include <string.h>
+
+#include "fxchat.h"
+#include "fxchat_context.h"
+
+xchat_context *CurrentContext()
+{
+   return xchat_get_context( the_plugin );
+}
+
+bool SwitchContext( xchat_context *ctx )
+{
+   if ( ctx == CurrentContext() )
+      return true;
+
+   return xchat_set_context( the_plugin, ctx ) != 0;
+}
+
+//==============================================
+// Context objects cache
+//
+
+#define CACHE_INITIAL_BUCKETS 16
+
+static ContextCache *s_caches = 0;
+
+ContextCarrier::~ContextCarrier()
+{
+   if ( m_entry != 0 )
+   {
+      __sync_lock_test_and_set( &m_entry->m_dead, 1 );
+      m_entry->decref();
+   }
+}
+
+ContextCache::ContextCache():
+   m_mask( CACHE_INITIAL_BUCKETS - 1 ),
+   m_count( 0 ),
+   m_prev( 0 )
+{
+   m_buckets = new ContextEntry*[ CACHE_INITIAL_BUCKETS ];
+   memset( m_buckets, 0, sizeof( ContextEntry* ) * CACHE_INITIAL_BUCKETS );
+
+   m_next = s_caches;
+   if ( s_caches != 0 )
+      s_caches->m_prev = this;
+   s_caches = this;
+}
+
+ContextCache::~ContextCache()
+{
+   // the collector will destroy the carriers later.
+   for( Falcon::uint32 i = 0; i <= m_mask; i++ )
+   {
+      while( m_buckets[i] != 0 )
+         drop( &m_buckets[i] );
+   }
+   delete[] m_buckets;
+
+   if ( m_prev != 0 )
+      m_prev->m_next = m_next;
+   else
+      s_caches = m_next;
+   if ( m_next != 0 )
+      m_next->m_prev = m_prev;
+}
+
+ContextEntry **ContextCache::bucket( xchat_context *ctx ) const
+{
+   // the low bits of a pointer are always the same.
+   Falcon::uint32 h = (Falcon::uint32) ( (size_t) ctx >> 4 ) * 2654435761U;
+   return &m_buckets[ ( h >> 16 ) & m_mask ];
+}
+
+void ContextCache::drop( ContextEntry **pe )
+{
+   ContextEntry *e = *pe;
+   *pe = e->m_nextInBucket;
+   --m_count;
+   e->decref();
+}
+
+void ContextCache::grow()
+{
+   ContextEntry **old = m_buckets;
+   Falcon::uint32 oldSize = m_mask + 1;
+
+   m_mask = oldSize * 2 - 1;
+   m_buckets = new ContextEntry*[ m_mask + 1 ];
+   memset( m_buckets, 0, sizeof( ContextEntry* ) * ( m_mask + 1 ) );
+
+   for( Falcon::uint32 i = 0; i < oldSize; i++ )
+   {
+      while( old[i] != 0 )
+      {
+         // a good time to get rid of the dead ones.
+         if ( old[i]->m_dead )
+         {
+            drop( &old[i] );
+            continue;
+         }
+
+         ContextEntry *e = old[i];
+         old[i] = e->m_nextInBucket;
+         ContextEntry **b = bucket( e->m_ctx );
+         e->m_nextInBucket = *b;
+         *b = e;
+      }
+   }
+
+   delete[] old;
+}
+
+Falcon::CoreObject *ContextCache::find( xchat_context *ctx )
+{
+   ContextEntry **pe = bucket( ctx );
+   while( *pe != 0 )
+   {
+      ContextEntry *e = *pe;
+      if ( e->m_dead )
+      {
+         drop( pe );
+         continue;
+      }
+
+      if ( e->m_ctx == ctx )
+         return e->m_object;
+
+      pe = &e->m_nextInBucket;
+   }
+
+   return 0;
+}
+
+void ContextCache::insert( ContextCarrier *carrier, Falcon::CoreObject *object )
+{
+   if ( m_count > m_mask )
+      grow();
+
+   ContextEntry *e = new ContextEntry( carrier->m_ctx, object );
+   carrier->m_entry = e;
+
+   ContextEntry **b = bucket( e->m_ctx );
+   e->m_nextInBucket = *b;
+   *b = e;
+   ++m_count;
+}
+
+void ContextCache::closeContext( xchat_context *ctx )
+{
+   for( ContextCache *cache = s_caches; cache != 0; cache = cache->m_next )
+   {
+      ContextEntry **pe = cache->bucket( ctx );
+      while( *pe != 0 )
+      {
+         // xchat may give the same address to a new context.
+         if ( (*pe)->m_ctx == ctx || (*pe)->m_dead )
+            cache->drop( pe );
+         else
+            pe = &(*pe)->m_nextInBucket;
+      }
+   }
+}
+
+xchat_context *ObjectContext( Falcon::CoreObject *obj )
+{
+   ContextCarrier *carrier = static_cast<ContextCarrier *>( (Falcon::FalconData *) obj->getUserData() );
+   return carrier != 0 ? carrier->context() : 0;
+}
+
+extern "C" int close_context_cb( char *word[], void *user_data )
+{
+   // the event is raised in the context being closed.
+   ContextCache::closeContext( xchat_get_context( the_plugin ) );
+   return XCHAT_EAT_NONE;
+}
+
+void InitContextCache()
+{
+   // before any script can eat the event.
+   xchat_hook_print( the_plugin, "Close Context", XCHAT_PRI_HIGHEST, close_context_cb, 0 );
+}
+
+/* end of fxchat_context.cpp */
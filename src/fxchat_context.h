@@ -0,0 +1,132 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_context.h
+
+   Falcon script Xchat plugin
+   Current context tracking and context objects
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 15:01:51
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Current context tracking and context objects.
+*/
+
+#ifndef fxchat_context_H
+#define fxchat_context_H
+
+#include <falcon/engine.h>
+#include <falcon/falcondata.h>
+#include "xchat-plugin.h"
+
+// Setting the context makes xchat validate it against all its open
+// sessions; reading it is just a field access. Switching to the
+// context that is already current is then skipped; as xchat is always
+// asked for the current context, it can change it at will.
+
+// The current xchat context.
+xchat_context *CurrentContext();
+
+// Makes a context current; returns false if it doesn't exist anymore.
+bool SwitchContext( xchat_context *ctx );
+
+// Entry of a context cache, shared by the cache and by the carrier in
+// the object. The collector may destroy the object in any thread; so,
+// the carrier just marks the entry as dead, and the cache drops it on
+// the main thread. Whoever releases the entry last deletes it.
+class ContextEntry
+{
+public:
+   xchat_context *m_ctx;
+   Falcon::CoreObject *m_object;
+   ContextEntry *m_nextInBucket;
+
+   volatile int m_dead;
+   volatile int m_refs;
+
+   ContextEntry( xchat_context *ctx, Falcon::CoreObject *object ):
+      m_ctx( ctx ),
+      m_object( object ),
+      m_nextInBucket( 0 ),
+      m_dead( 0 ),
+      m_refs( 2 )
+   {}
+
+   void decref()
+   {
+      if ( __sync_sub_and_fetch( &m_refs, 1 ) == 0 )
+         delete this;
+   }
+};
+
+// Carrier of the xchat context in the XChatContext instances. The cache
+// doesn't keep the objects alive; when one is destroyed, its carrier
+// marks the cache entry as dead.
+class ContextCarrier: public Falcon::FalconData
+{
+   xchat_context *m_ctx;
+   ContextEntry *m_entry;
+
+   friend class ContextCache;
+
+public:
+   ContextCarrier( xchat_context *ctx ):
+      m_ctx( ctx ),
+      m_entry( 0 )
+   {}
+
+   virtual ~ContextCarrier();
+
+   xchat_context *context() const { return m_ctx; }
+
+   virtual Falcon::FalconData* clone() const { return 0; }
+   virtual void gcMark( Falcon::uint32 ) {}
+};
+
+// The XChatContext instances of a VM, by xchat context; main thread only.
+// Contexts are removed when xchat closes them.
+class ContextCache
+{
+   ContextEntry **m_buckets;
+   Falcon::uint32 m_mask;
+   Falcon::uint32 m_count;
+
+   // all the caches, to remove closed contexts.
+   ContextCache *m_next;
+   ContextCache *m_prev;
+
+   ContextEntry **bucket( xchat_context *ctx ) const;
+   void grow();
+   // Unlinks an entry, given the pointer to it.
+   void drop( ContextEntry **pe );
+
+public:
+   ContextCache();
+   // the objects still alive stay valid.
+   ~ContextCache();
+
+   // Finds the living object of a context; drops the dead entries found.
+   Falcon::CoreObject *find( xchat_context *ctx );
+   // Records a new object, with its carrier.
+   void insert( ContextCarrier *carrier, Falcon::CoreObject *object );
+
+   // Removes a context from all the caches.
+   static void closeContext( xchat_context *ctx );
+};
+
+// Returns the context of an XChatContext instance (0 if it has none).
+xchat_context *ObjectContext( Falcon::CoreObject *obj );
+
+// Hooks the closing of the contexts.
+void InitContextCache();
+
+#endif
+
+/* end of fxchat_context.h */
@@ -0,0 +1,444 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_dispatch.cpp
+
+   Falcon script Xchat plugin
+   Shared dispatcher for server messages
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:28:26
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Shared dispatcher for server messages.
+*/
+
+#include <falcon/engine.h>
+
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+#include <map>
+
+#include "fxchat.h"
+#include "fxchat_dispatch.h"
+#include "fxchat_hook.h"
+
+//==============================================
+// Parsed message record
+//
+
+ServerMessage::ServerMessage( char *word[], char *word_eol[], const ParamDescList *params ):
+   m_word( word ),
+   m_word_eol( word_eol ),
+   m_wordCount( 1 ),
+   m_params( params ),
+   m_fieldCount( 0 ),
+   m_source( 0 )
+{
+   // the list of words is terminated by an empty word.
+   while( m_wordCount < MAX_WORDS && word[m_wordCount] != 0 && word[m_wordCount][0] != '\0' )
+      ++m_wordCount;
+
+   if ( m_wordCount < 2 )
+      return;
+
+   // the first word generally contains an extra ":" at the beginning.
+   m_source = word[1][0] == ':' ? word[1] + 1 : word[1];
+   m_prefix.parse( m_source );
+
+   if ( params == 0 )
+      return;
+
+   ParamDescList::const_iterator liter = params->begin();
+   int idWord = 1;
+   while( liter != params->end() && idWord < m_wordCount && m_fieldCount < MAX_FIELDS )
+   {
+      const char *curWord = word[idWord];
+
+      if ( idWord == 1 )
+      {
+         m_fields[ m_fieldCount++ ] = m_source;
+      }
+      // in managed messages, a ":" beyond the first element means "all the reset".
+      else if ( curWord[0] == ':' )
+      {
+         m_fields[ m_fieldCount++ ] = word_eol[idWord] + 1;
+         // this will be the last field
+         break;
+      }
+      else {
+         m_fields[ m_fieldCount++ ] = curWord;
+      }
+
+      ++liter;
+      ++idWord;
+   }
+}
+
+//==============================================
+// Shared hooks
+//
+
+class ServerChannel
+{
+public:
+   Falcon::String m_match;
+   const ParamDescList *m_params;
+   // numeric channels have no xchat hook of their own
+   int m_code;
+   xchat_hook *m_hook;
+   int m_priority;
+
+   // subscribers, highest priority first
+   std::vector<XChatHook *> m_subs;
+   // subscribers added while dispatching
+   std::vector<XChatHook *> m_pending;
+   int m_dispatching;
+   bool m_bDirty;
+
+   ServerChannel( const Falcon::String &match, const ParamDescList *params, int code = -1 ):
+      m_match( match ),
+      m_params( params ),
+      m_code( code ),
+      m_hook( 0 ),
+      m_priority( XCHAT_PRI_NORM ),
+      m_dispatching( 0 ),
+      m_bDirty( false )
+   {
+      m_match.bufferize();
+   }
+
+   void insert( XChatHook *hook );
+};
+
+typedef std::map< Falcon::String, ServerChannel *, StringCompareIgnoreCase > ChannelMap;
+static ChannelMap s_channels;
+
+// Ranges of numeric replies are dispatched by their code through a single
+// RAW LINE hook; hooks on a single code have their own channel.
+static ServerChannel *s_numerics[ 1000 ];
+static int s_numericCount = 0;
+static xchat_hook *s_rawHook = 0;
+static int s_rawPriority = XCHAT_PRI_NORM;
+
+void ServerChannel::insert( XChatHook *hook )
+{
+   // keep the order of subscription among hooks with the same priority
+   std::vector<XChatHook *>::iterator iter = m_subs.begin();
+   while( iter != m_subs.end() && (*iter)->priority() >= hook->priority() )
+      ++iter;
+
+   m_subs.insert( iter, hook );
+}
+
+
+extern "C" int dispatch_server_cb( char *word[], char *word_eol[], void *user_data );
+extern "C" int dispatch_raw_cb( char *word[], char *word_eol[], void *user_data );
+
+// Installs the RAW LINE hook, or moves it to a higher priority.
+static bool internal_raw_hook( int priority )
+{
+   if ( s_rawHook != 0 && priority <= s_rawPriority )
+      return true;
+
+   xchat_hook *hook = xchat_hook_server( the_plugin, "RAW LINE", priority,
+         dispatch_raw_cb, 0 );
+   if ( hook == 0 )
+      return false;
+
+   if ( s_rawHook != 0 )
+      xchat_unhook( the_plugin, s_rawHook );
+
+   s_rawHook = hook;
+   s_rawPriority = priority;
+   return true;
+}
+
+static bool internal_rehook( ServerChannel *chn, int priority )
+{
+   if ( chn->m_code >= 0 )
+      return internal_raw_hook( priority );
+
+   Falcon::AutoCString match( chn->m_match );
+   xchat_hook *hook = xchat_hook_server( the_plugin, match.c_str(), priority,
+         dispatch_server_cb, chn );
+   if ( hook == 0 )
+      return false;
+
+   if ( chn->m_hook != 0 )
+      xchat_unhook( the_plugin, chn->m_hook );
+
+   chn->m_hook = hook;
+   chn->m_priority = priority;
+   return true;
+}
+
+// Applies the changes made during the dispatch and releases empty channels.
+static void internal_settle( ServerChannel *chn )
+{
+   if ( chn->m_bDirty )
+   {
+      std::vector<XChatHook *>::iterator iter = chn->m_subs.begin();
+      while( iter != chn->m_subs.end() )
+      {
+         if ( *iter == 0 )
+            iter = chn->m_subs.erase( iter );
+         else
+            ++iter;
+      }
+      chn->m_bDirty = false;
+   }
+
+   for( size_t i = 0; i < chn->m_pending.size(); i++ )
+   {
+      chn->insert( chn->m_pending[i] );
+   }
+   chn->m_pending.clear();
+
+   if ( chn->m_subs.empty() )
+   {
+      if ( chn->m_code >= 0 )
+      {
+         s_numerics[ chn->m_code ] = 0;
+         if ( --s_numericCount == 0 )
+         {
+            xchat_unhook( the_plugin, s_rawHook );
+            s_rawHook = 0;
+            s_rawPriority = XCHAT_PRI_NORM;
+         }
+      }
+      else {
+         xchat_unhook( the_plugin, chn->m_hook );
+         s_channels.erase( chn->m_match );
+      }
+      delete chn;
+   }
+   // let xchat see the hook at the priority of the most important subscriber
+   else if ( chn->m_subs.front()->priority() > chn->m_priority )
+   {
+      internal_rehook( chn, chn->m_subs.front()->priority() );
+   }
+}
+
+
+static int internal_dispatch( ServerChannel *chn, char *word[], char *word_eol[] )
+{
+   // parse the line once for everyone.
+   ServerMessage msg( word, word_eol, chn->m_params );
+
+   int result = XCHAT_EAT_NONE;
+   chn->m_dispatching++;
+
+   // subscribers added during the dispatch will receive the next message.
+   size_t count = chn->m_subs.size();
+   for( size_t i = 0; i < count; i++ )
+   {
+      XChatHook *hook = chn->m_subs[i];
+
+      // was it unsubscribed during the dispatch?
+      if ( hook == 0 )
+         continue;
+
+      // the hook may be destroyed by now; don't use it anymore.
+      int ret = DeliverServerMessage( hook, msg );
+      result |= ret;
+
+      // the script doesn't want other handlers to see this message
+      if ( (ret & XCHAT_EAT_PLUGIN) != 0 )
+         break;
+   }
+
+   if ( --chn->m_dispatching == 0 )
+      internal_settle( chn );
+
+   return result;
+}
+
+
+extern "C" int dispatch_server_cb( char *word[], char *word_eol[], void *user_data )
+{
+   return internal_dispatch( (ServerChannel *) user_data, word, word_eol );
+}
+
+
+extern "C" int dispatch_raw_cb( char *word[], char *word_eol[], void *user_data )
+{
+   // numeric replies always have a prefix, followed by three digits.
+   if ( word[1] == 0 || word[1][0] != ':' || word[2] == 0 )
+      return XCHAT_EAT_NONE;
+
+   const char *cmd = word[2];
+   if ( ! isdigit( (unsigned char) cmd[0] ) || ! isdigit( (unsigned char) cmd[1] ) ||
+         ! isdigit( (unsigned char) cmd[2] ) || cmd[3] != '\0' )
+      return XCHAT_EAT_NONE;
+
+   ServerChannel *chn = s_numerics[ (cmd[0] - '0') * 100 + (cmd[1] - '0') * 10 + (cmd[2] - '0') ];
+   if ( chn == 0 )
+      return XCHAT_EAT_NONE;
+
+   return internal_dispatch( chn, word, word_eol );
+}
+
+
+bool ParseNumericRange( const Falcon::String &match, int &first, int &last )
+{
+   // three characters: digits, optionally followed by "x" wildcards.
+   if ( match.length() != 3 )
+      return false;
+
+   first = 0;
+   last = 0;
+   bool bWild = false;
+   for( int i = 0; i < 3; i++ )
+   {
+      Falcon::uint32 chr = match.getCharAt( i );
+      if ( chr == 'x' || chr == 'X' )
+      {
+         bWild = true;
+         first = first * 10;
+         last = last * 10 + 9;
+      }
+      else if ( chr >= '0' && chr <= '9' && ! bWild )
+      {
+         first = first * 10 + (chr - '0');
+         last = last * 10 + (chr - '0');
+      }
+      else
+         return false;
+   }
+
+   return true;
+}
+
+
+static void internal_subscribe( ServerChannel *chn, XChatHook *hook )
+{
+   if ( chn->m_dispatching > 0 )
+   {
+      chn->m_pending.push_back( hook );
+   }
+   else {
+      chn->insert( hook );
+      if ( hook->priority() > chn->m_priority )
+         internal_rehook( chn, hook->priority() );
+   }
+}
+
+static bool internal_subscribe_numeric( XChatHook *hook )
+{
+   // the raw hook must be in place before creating any channel.
+   if ( ! internal_raw_hook( hook->priority() ) )
+      return false;
+
+   for( int code = hook->numFirst(); code <= hook->numLast(); code++ )
+   {
+      ServerChannel *chn = s_numerics[ code ];
+      if ( chn == 0 )
+      {
+         char name[4];
+         name[0] = (char) ( '0' + code / 100 );
+         name[1] = (char) ( '0' + (code / 10) % 10 );
+         name[2] = (char) ( '0' + code % 10 );
+         name[3] = '\0';
+
+         Falcon::String match( name );
+         chn = new ServerChannel( match, FindSrvMsgParams( match ), code );
+         chn->m_priority = s_rawPriority;
+         s_numerics[ code ] = chn;
+         ++s_numericCount;
+      }
+
+      internal_subscribe( chn, hook );
+   }
+
+   hook->dispatched( true );
+   return true;
+}
+
+
+bool SubscribeServer( XChatHook *hook )
+{
+   if ( hook->numeric() )
+      return internal_subscribe_numeric( hook );
+
+   ChannelMap::iterator iter = s_channels.find( hook->match() );
+   if ( iter != s_channels.end() )
+   {
+      internal_subscribe( iter->second, hook );
+      hook->dispatched( true );
+      return true;
+   }
+
+   ServerChannel *chn = new ServerChannel( hook->match(), hook->params() );
+   if ( ! internal_rehook( chn, hook->priority() ) )
+   {
+      delete chn;
+      return false;
+   }
+
+   chn->m_subs.push_back( hook );
+   s_channels[ chn->m_match ] = chn;
+   hook->dispatched( true );
+   return true;
+}
+
+
+static void internal_unsubscribe( ServerChannel *chn, XChatHook *hook )
+{
+   for( size_t i = 0; i < chn->m_pending.size(); i++ )
+   {
+      if ( chn->m_pending[i] == hook )
+      {
+         chn->m_pending.erase( chn->m_pending.begin() + i );
+         break;
+      }
+   }
+
+   for( size_t i = 0; i < chn->m_subs.size(); i++ )
+   {
+      if ( chn->m_subs[i] == hook )
+      {
+         if ( chn->m_dispatching > 0 )
+         {
+            // the dispatch loop is using the vector; just void the entry.
+            chn->m_subs[i] = 0;
+            chn->m_bDirty = true;
+         }
+         else
+            chn->m_subs.erase( chn->m_subs.begin() + i );
+         break;
+      }
+   }
+
+   if ( chn->m_dispatching == 0 )
+      internal_settle( chn );
+}
+
+
+void UnsubscribeServer( XChatHook *hook )
+{
+   hook->dispatched( false );
+
+   if ( hook->numeric() )
+   {
+      for( int code = hook->numFirst(); code <= hook->numLast(); code++ )
+      {
+         if ( s_numerics[ code ] != 0 )
+            internal_unsubscribe( s_numerics[ code ], hook );
+      }
+      return;
+   }
+
+   ChannelMap::iterator iter = s_channels.find( hook->match() );
+   if ( iter != s_channels.end() )
+      internal_unsubscribe( iter->second, hook );
+}
+
+/* end of fxchat_dispatch.cpp */
@@ -0,0 +1,85 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_dispatch.h
+
+   Falcon script Xchat plugin
+   Shared dispatcher for server messages
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:28:26
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Shared dispatcher for server messages.
+*/
+
+#ifndef fxchat_dispatch_H
+#define fxchat_dispatch_H
+
+#include "fxchat_events.h"
+#include "fxchat_prefix.h"
+
+class XChatHook;
+
+// A server message, parsed once and shared by all the scripts
+// hooking it. The record only refers to the xchat words, so it's
+// valid only during the xchat callback.
+class ServerMessage
+{
+public:
+   enum { MAX_WORDS = 32, MAX_FIELDS = 16 };
+
+   ServerMessage( char *word[], char *word_eol[], const ParamDescList *params );
+
+   char **word() const { return m_word; }
+   char **word_eol() const { return m_word_eol; }
+   int wordCount() const { return m_wordCount; }
+   const ParamDescList *params() const { return m_params; }
+
+   // value of the nth parameter of the plan, or 0 if not present.
+   const char *field( int pos ) const { return pos >= 0 && pos < m_fieldCount ? m_fields[pos] : 0; }
+   int fieldCount() const { return m_fieldCount; }
+
+   // The sender, stripped of the leading ":" (0 if not present).
+   const char *source() const { return m_source; }
+   // nick!user@host split of the sender.
+   const IrcPrefix &prefix() const { return m_prefix; }
+
+private:
+   char **m_word;
+   char **m_word_eol;
+   int m_wordCount;
+   const ParamDescList *m_params;
+
+   const char *m_fields[ MAX_FIELDS ];
+   int m_fieldCount;
+
+   const char *m_source;
+   IrcPrefix m_prefix;
+};
+
+// Subscribes a script hook to the shared xchat hook of its server message,
+// creating the xchat hook if this is the first subscriber.
+// Returns false if xchat refused the hook.
+bool SubscribeServer( XChatHook *hook );
+
+// Removes a script hook from the shared hook; the xchat hook is released
+// when it has no more subscribers. Safe to be called during the dispatch.
+void UnsubscribeServer( XChatHook *hook );
+
+// Checks if a server hook match is a numeric reply or a range of them,
+// as "352" or "3xx", and returns the range.
+bool ParseNumericRange( const Falcon::String &match, int &first, int &last );
+
+// Delivers a message to a script hook; implemented along with the other callbacks.
+int DeliverServerMessage( XChatHook *hook, const ServerMessage &msg );
+
+#endif
+
+/* end of fxchat_dispatch.h */
@@ -40,18 +40,8 @@ void XChatErrHand::handleError( Falcon::Error *error, ScriptData* module )
 	Falcon::String str;
    error->toString( str );
 
-   // now prefix every row with "plugin name"
-   str = (PNAME ": ") + str;
-
-   Falcon::uint32 pos = str.find( "\n" );
-   while( pos != Falcon::String::npos )
-   {
-   	pos++;
-   	str.insert( pos, 0, PNAME ": " );
-   	pos = str.find( "\n", pos );
-   }
-
-   xchat_print_falcon( str );
+   // every row is prefixed with the plugin name.
+   xchat_print_falcon( PNAME ": ", str );
 }
 
 /* end of fxchat_errhand.cpp */
@@ -22,9 +22,6 @@
 #ifndef FX_EVENTS_H
 #define FX_EVENTS_H
 
-#include <map>
-#include <list>
-
 #include <falcon/string.h>
 #include <falcon/autocstring.h>
 #include <stdio.h>
@@ -39,25 +36,62 @@ public:
    }
 };
 
-class ParamDesc
+// Parameter descriptors are plain aggregates, so that the tables
+// generated by makeevents.fal are built by the compiler.
+struct ParamDesc
 {
-public:
 	const char *m_param;
 	const char *m_desc;
-	ParamDesc( const char *p, const char *d ):
-		m_param( p ),
-		m_desc( d )
-   {}
+	// index of m_param in the key atom table; -1 for skipped words ("-")
+	int m_key;
+};
+
+// Fixed key atoms, used by callbacks outside of the parameter maps.
+// Parameter names found in the maps are numbered after these.
+enum
+{
+   KEY_EVENT,
+   KEY_NICK,
+   KEY_NICK_USER,
+   KEY_NICK_NET,
+   KEY_WORDLIST,
+   KEY_CONTEXT,
+   KEY_FIRST_PARAM
+};
+
+// A contiguous slice of a parameter table.
+struct ParamDescList
+{
+   typedef const ParamDesc *const_iterator;
+
+   const ParamDesc *m_first;
+   int m_count;
+
+   const_iterator begin() const { return m_first; }
+   const_iterator end() const { return m_first + m_count; }
+   int size() const { return m_count; }
+   bool empty() const { return m_count == 0; }
+};
+
+struct EventDesc
+{
+   const char *m_name;
+   ParamDescList m_params;
 };
 
-typedef std::list< ParamDesc > ParamDescList;
-typedef std::map< Falcon::String, ParamDescList, StringCompareIgnoreCase > ParamMap;
+// Parameter plans are resolved once, when a hook is created;
+// a zero return means that the event or message is unmanaged.
+const ParamDescList *FindEventParams( const Falcon::String &event );
+const ParamDescList *FindSrvMsgParams( const Falcon::String &msg );
 
-extern ParamMap s_PMevent;
-extern ParamMap s_PMsrvmsg;
+// Static tables, sorted by name.
+int EventCount();
+const EventDesc &EventAt( int id );
+int SrvMsgCount();
+const EventDesc &SrvMsgAt( int id );
 
-void LoadEventParamMap();
-void LoadSrvMsgParamMap();
+int ParamKeyCount();
+const char *ParamKeyName( int key );
 
 #endif
 
@@ -0,0 +1,1114 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_evtable.h
+
+   Falcon script Xchat plugin
+   Static tables of event and server message parameters
+   -------------------------------------------------------------------
+   Generated by makeevents.fal from fxchat_events.def; DO NOT EDIT.
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Static tables of event and server message parameters.
+   To be included by fxchat_events.cpp only.
+*/
+
+// Key atoms; the first ones are the fixed KEY_* atoms.
+static const char * const s_keyNames[] = {
+   "event",
+   "nick",
+   "nick:user",
+   "nick:net",
+   "wordlist",
+   "context",
+   "channel",
+   "mask",
+   "banner",
+   "time",
+   "newnick",
+   "action",
+   "mode",
+   "opper",
+   "opped",
+   "message",
+   "idtext",
+   "sign",
+   "text",
+   "key",
+   "limit",
+   "host",
+   "ip",
+   "port",
+   "error",
+   "ctcp",
+   "receiver",
+   "sound",
+   "address",
+   "type",
+   "dcc",
+   "packet",
+   "file",
+   "path",
+   "destfile",
+   "cps",
+   "Filename",
+   "newfile",
+   "position",
+   "size",
+   "left",
+   "right",
+   "name",
+   "server",
+   "state",
+   "string",
+   "length",
+   "kicker",
+   "reason",
+   "tesxt",
+   "from",
+   "number",
+   "network",
+   "seconds",
+   "idText",
+   "modes",
+   "topic",
+   "creator",
+   "users",
+   "account",
+   "member",
+   "idle",
+   "signon",
+   "user",
+   "real",
+   "info",
+   "kicked",
+   "nick:all",
+   "target",
+   "version",
+   "usermodes",
+   "chanmodes",
+   "subject",
+   "realname",
+   "channels",
+   "setter",
+   "flags",
+   "names",
+   "command",
+   "invited",
+   "entity",
+   "lag",
+   "hopcount",
+   "comment",
+};
+static const int s_keyCount = 84;
+
+//==============================================
+// Print events
+//
+
+static const ParamDesc s_eventParams[] = {
+   // Add Notify
+   { "nick", "Nickname", 1 },
+   // Ban List
+   { "channel", "Channel Name", 6 },
+   { "mask", "Mask used for ban", 7 },
+   { "banner", "Who set the ban", 8 },
+   { "time", "Ban time", 9 },
+   // Banned
+   { "channel", "Channel Name", 6 },
+   // Change Nick
+   { "nick", "Old nickname", 1 },
+   { "newnick", "New nickname", 10 },
+   // Channel Action
+   { "nick", "Nickname", 1 },
+   { "action", "The action", 11 },
+   { "mode", "Mode char", 12 },
+   // Channel Action Hilight
+   { "nick", "Nickname", 1 },
+   { "action", "The action", 11 },
+   { "mode", "Mode char", 12 },
+   // Channel Ban
+   { "banner", "The nick of the person who did the banning", 8 },
+   { "mask", "The ban mask", 7 },
+   // Channel Creation
+   { "channel", "The channel", 6 },
+   { "time", "The time", 9 },
+   // Channel DeHalfOp
+   { "opper", "The nick of the person of did the dehalfop'ing", 13 },
+   { "opped", "The nick of the person who has been dehalfop'ed", 14 },
+   // Channel DeOp
+   { "opper", "The nick of the person of did the deop'ing", 13 },
+   { "opped", "The nick of the person who has been deop'ed", 14 },
+   // Channel DeVoice
+   { "opper", "The nick of the person of did the devoice'ing", 13 },
+   { "opped", "The nick of the person who has been devoice'ed", 14 },
+   // Channel Exempt
+   { "opper", "The nick of the person who did the exempt", 13 },
+   { "opped", "The exempt mask", 14 },
+   // Channel Half-Operator
+   { "opper", "The nick of the person who has been halfop'ed", 13 },
+   { "opped", "The nick of the person who did the halfop'ing", 14 },
+   // Channel INVITE
+   { "nick", "The nick of the person who did the invite", 1 },
+   { "mask", "The invite mask", 7 },
+   // Channel Message
+   { "nick", "Nickname", 1 },
+   { "message", "The text", 15 },
+   { "mode", "Mode char", 12 },
+   { "idtext", "Identified text", 16 },
+   // Channel Mode Generic
+   { "nick", "The nick of the person setting the mode", 1 },
+   { "sign", "The mode's sign (+/-)", 17 },
+   { "mode", "The mode letter", 12 },
+   { "channel", "The channel it's being set on", 6 },
+   // Channel Modes
+   { "channel", "Channel Name", 6 },
+   { "mode", "Modes string", 12 },
+   // Channel Msg Hilight
+   { "nick", "Nickname", 1 },
+   { "text", "The text", 18 },
+   { "mode", "Mode char", 12 },
+   { "idtext", "Identified text", 16 },
+   // Channel Notice
+   { "nick", "Who it's from", 1 },
+   { "channel", "The Channel it's going to", 6 },
+   { "message", "The message", 15 },
+   // Channel Operator
+   { "opper", "The nick of the person who did the op'ing", 13 },
+   { "opped", "The nick of the person who has been op'ed", 14 },
+   // Channel Remove Exempt
+   { "nick", "The nick of the person removed the exempt", 1 },
+   { "mask", "The exempt mask", 7 },
+   // Channel Remove Invite
+   { "nick", "The nick of the person removed the invite", 1 },
+   { "mask", "The invite mask", 7 },
+   // Channel Remove Keyword
+   { "nick", "The nick who removed the key", 1 },
+   // Channel Remove Limit
+   { "nick", "The nick who removed the limit", 1 },
+   // Channel Set Key
+   { "nick", "The nick of the person who set the key", 1 },
+   { "key", "The key", 19 },
+   // Channel Set Limit
+   { "nick", "The nick of the person who set the limit", 1 },
+   { "limit", "The limit", 20 },
+   // Channel UnBan
+   { "nick", "The nick of the person of did the unban'ing", 1 },
+   { "mask", "The ban mask", 7 },
+   // Channel Voice
+   { "opper", "The nick of the person who did the voice'ing", 13 },
+   { "opped", "The nick of the person who has been voice'ed", 14 },
+   // Connecting
+   { "host", "Host", 21 },
+   { "ip", "IP", 22 },
+   { "port", "Port", 23 },
+   // Connection Failed
+   { "error", "Error", 24 },
+   // CTCP Generic
+   { "ctcp", "The CTCP event", 25 },
+   { "nick", "The nick of the person", 1 },
+   // CTCP Generic to Channel
+   { "ctcp", "The CTCP event", 25 },
+   { "nick", "The nick of the person", 1 },
+   { "channel", "The Channel it's going to", 6 },
+   // CTCP Send
+   { "receiver", "Receiver", 26 },
+   { "message", "Message", 15 },
+   // CTCP Sound
+   { "sound", "The sound", 27 },
+   { "nick", "The nick of the person", 1 },
+   // CTCP Sound to Channel
+   { "sound", "The sound", 27 },
+   { "nick", "The nick of the person", 1 },
+   { "channel", "The channel", 6 },
+   // DCC CHAT Abort
+   { "nick", "Nickname", 1 },
+   // DCC CHAT Connect
+   { "nick", "Nickname", 1 },
+   { "nick", "IP address", 1 },
+   // DCC CHAT Failed
+   { "nick", "Nickname", 1 },
+   { "ip", "IP address", 22 },
+   { "port", "Port", 23 },
+   { "error", "Error", 24 },
+   // DCC CHAT Offer
+   { "nick", "Nickname", 1 },
+   // DCC CHAT Offering
+   { "nick", "Nickname", 1 },
+   // DCC CHAT Reoffer
+   { "nick", "Nickname", 1 },
+   // DCC Chat Text
+   { "address", "Address", 28 },
+   { "port", "Port", 23 },
+   { "nick", "Nick", 1 },
+   { "message", "Message", 15 },
+   // DCC Conection Failed
+   { "type", "DCC Type", 29 },
+   { "nick", "Nickname", 1 },
+   { "error", "Error", 24 },
+   // DCC Generic Offer
+   { "dcc", "DCC String", 30 },
+   { "nick", "Nickname", 1 },
+   // DCC Malformed
+   { "nick", "Nickname", 1 },
+   { "packet", "The Packet", 31 },
+   // DCC Offer
+   { "file", "Filename", 32 },
+   { "nick", "Nickname", 1 },
+   { "path", "Pathname", 33 },
+   // DCC RECV Abort
+   { "nick", "Nickname", 1 },
+   { "file", "Filename", 32 },
+   // DCC RECV Complete
+   { "file", "Filename", 32 },
+   { "destfile", "Destination filename", 34 },
+   { "nick", "Nickname", 1 },
+   { "cps", "CPS - transfer speed in character per seconds", 35 },
+   // DCC RECV Connect
+   { "nick", "Nickname", 1 },
+   { "ip", "IP address", 22 },
+   { "file", "Filename", 32 },
+   // DCC RECV Failed
+   { "file", "Filename", 32 },
+   { "destfile", "Destination filename", 34 },
+   { "nick", "Nickname", 1 },
+   { "error", "Error", 24 },
+   // DCC RECV File Open Error
+   { "Filename", "Filename", 36 },
+   { "error", "Error", 24 },
+   // DCC Rename
+   { "file", "Old Filename", 32 },
+   { "newfile", "New Filename", 37 },
+   // DCC RESUME Request
+   { "nick", "Nickname", 1 },
+   { "error", "Filename", 24 },
+   { "position", "Position", 38 },
+   // DCC SEND Abort
+   { "nick", "Nickname", 1 },
+   { "file", "Filename", 32 },
+   // DCC SEND Complete
+   { "file", "Filename", 32 },
+   { "nick", "Nickname", 1 },
+   { "cps", "CPS", 35 },
+   // DCC SEND Connect
+   { "nick", "Nickname", 1 },
+   { "ip", "IP address", 22 },
+   { "file", "Filename", 32 },
+   // DCC SEND Failed
+   { "file", "Filename", 32 },
+   { "nick", "Nickname", 1 },
+   { "error", "Error", 24 },
+   // DCC SEND Offer
+   { "nick", "Nickname", 1 },
+   { "file", "Filename", 32 },
+   { "size", "Size", 39 },
+   { "ip", "IP address", 22 },
+   // DCC Stall
+   { "type", "DCC Type", 29 },
+   { "file", "Filename", 32 },
+   { "nick", "Nickname", 1 },
+   // DCC Timeout
+   { "type", "DCC Type", 29 },
+   { "file", "Filename", 32 },
+   { "nick", "Nickname", 1 },
+   // Delete Notify
+   { "nick", "Nickname", 1 },
+   // Disconnected
+   { "error", "Error", 24 },
+   // Found IP
+   { "ip", "IP", 22 },
+   // Generic Message
+   { "left", "Left message", 40 },
+   { "right", "Right message", 41 },
+   // Ignore Add
+   { "mask", "Hostmask", 7 },
+   // Ignore Changed
+   { "mask", "Hostmask", 7 },
+   // Ignore Remove
+   { "mask", "Hostmask", 7 },
+   // Invite
+   { "name", "Channel Name", 42 },
+   // Invited
+   { "name", "Channel Name", 42 },
+   { "nick", "Nick of person who invited you", 1 },
+   { "server", "Server Name", 43 },
+   // Join
+   { "nick", "The nick of the joining person", 1 },
+   { "channel", "The channel being joined", 6 },
+   { "host", "The host of the person", 21 },
+   // Key Press
+   { "key", "Key Value", 19 },
+   { "state", "State Bitfield (shift, capslock, alt)", 44 },
+   { "string", "String version of the key", 45 },
+   { "length", "Length of the string (may be 0 for unprintable keys)", 46 },
+   // Keyword
+   { "name", "Channel Name", 42 },
+   // Kick
+   { "kicker", "The nickname of the kicker", 47 },
+   { "kicker", "The person being kicked", 47 },
+   { "channel", "The channel", 6 },
+   { "reason", "The reason", 48 },
+   // Killed
+   { "nick", "Nickname", 1 },
+   { "reason", "Reason", 48 },
+   // Message Send
+   { "receiver", "Receiver", 26 },
+   { "message", "Message", 15 },
+   // Motd
+   { "tesxt", "Text", 49 },
+   { "server", "Server Name", 43 },
+   // Nick Clash
+   { "nick", "Nickname in use", 1 },
+   { "newnick", "Nick being tried", 10 },
+   // Notice
+   { "from", "Who it's from", 50 },
+   { "message", "The message", 15 },
+   // Notice Send
+   { "receiver", "Receiver", 26 },
+   { "message", "Message", 15 },
+   // Notify Number
+   { "number", "Number of notify items", 51 },
+   // Notify Offline
+   { "nick", "Nickname", 1 },
+   { "server", "Server Name", 43 },
+   { "network", "Network", 52 },
+   // Notify Online
+   { "nick", "Nickname", 1 },
+   { "server", "Server Name", 43 },
+   { "network", "Network", 52 },
+   // Part
+   { "nick", "The nick of the person leaving", 1 },
+   { "host", "The host of the person", 21 },
+   { "channel", "The channel", 6 },
+   // Part with Reason
+   { "nick", "The nick of the person leaving", 1 },
+   { "host", "The host of the person", 21 },
+   { "channel", "The channel", 6 },
+   { "reason", "The reason", 48 },
+   // Ping Reply
+   { "from", "Who it's from", 50 },
+   { "time", "The time in x.x format (see below)", 9 },
+   // Ping Timeout
+   { "seconds", "Seconds", 53 },
+   // Private Message
+   { "nick", "Nickname", 1 },
+   { "message", "The message", 15 },
+   { "idText", "Identified text", 54 },
+   // Private Message to Dialog
+   { "nick", "Nickname", 1 },
+   { "message", "The message", 15 },
+   { "idText", "Identified text", 54 },
+   // Quit
+   { "nick", "Nick", 1 },
+   { "reason", "Reason", 48 },
+   { "host", "Host", 21 },
+   // Raw Modes
+   { "nick", "Nickname", 1 },
+   { "modes", "Modes string", 55 },
+   // Receive Wallops
+   { "nick", "Nickname", 1 },
+   { "message", "The message", 15 },
+   // Resolving User
+   { "nick", "Nickname", 1 },
+   { "host", "Hostname", 21 },
+   // Server Error
+   { "text", "Text", 18 },
+   // Server Lookup
+   { "server", "Server Name", 43 },
+   // Server Notice
+   { "text", "Text", 18 },
+   { "server", "Server Name", 43 },
+   // Server Text
+   { "text", "Text", 18 },
+   { "server", "Server Name", 43 },
+   // Topic
+   { "channel", "Channel", 6 },
+   { "topic", "Topic", 56 },
+   // Topic Change
+   { "nick", "Nick of person who changed the topic", 1 },
+   { "topic", "Topic", 56 },
+   { "channel", "Channel", 6 },
+   // Topic Creation
+   { "channel", "The channel", 6 },
+   { "creator", "The creator", 57 },
+   { "time", "The time", 9 },
+   // User Limit
+   { "name", "Channel Name", 42 },
+   // Users On Channel
+   { "name", "Channel Name", 42 },
+   { "users", "Users", 58 },
+   // WhoIs Authenticated
+   { "nick", "Nickname", 1 },
+   { "message", "Message", 15 },
+   { "account", "Account", 59 },
+   // WhoIs Away Line
+   { "nick", "Nickname", 1 },
+   { "reason", "Away reason", 48 },
+   // WhoIs Channel/Oper Line
+   { "nick", "Nickname", 1 },
+   { "member", "Channel Membership/\"is an IRC operator\"", 60 },
+   // WhoIs End
+   { "nick", "Nickname", 1 },
+   // WhoIs Identified
+   { "nick", "Nickname", 1 },
+   { "message", "Message", 15 },
+   // WhoIs Idle Line
+   { "nick", "Nickname", 1 },
+   { "idle", "Idle time", 61 },
+   // WhoIs Idle Line with Signon
+   { "nick", "Nickname", 1 },
+   { "idle", "Idle time", 61 },
+   { "signon", "Signon time", 62 },
+   // WhoIs Name Line
+   { "nick", "Nickname", 1 },
+   { "user", "Username", 63 },
+   { "host", "Host", 21 },
+   { "name", "Full name", 42 },
+   // WhoIs Real Host
+   { "nick", "Nickname", 1 },
+   { "real", "Real user@host", 64 },
+   { "ip", "Real IP", 22 },
+   { "message", "Message", 15 },
+   // WhoIs Server Line
+   { "nick", "Nickname", 1 },
+   { "info", "Server Information", 65 },
+   // WhoIs Special
+   { "nick", "Nickname", 1 },
+   { "message", "Message", 15 },
+   // You Join
+   { "nick", "The nick of the joining person", 1 },
+   { "channel", "The channel being joined", 6 },
+   { "host", "The host of the person", 21 },
+   // You Kicked
+   { "kicked", "The person being kicked", 66 },
+   { "channel", "The channel", 6 },
+   { "kicker", "The nickname of the kicker", 47 },
+   { "reason", "The reason", 48 },
+   // You Part
+   { "nick", "The nick of the person leaving", 1 },
+   { "host", "The host of the person", 21 },
+   { "channel", "The channel", 6 },
+   // You Part with Reason
+   { "nick", "The nick of the person leaving", 1 },
+   { "host", "The host of the person", 21 },
+   { "channel", "The channel", 6 },
+   { "reason", "The reason", 48 },
+   // Your Action
+   { "nick", "Nickname", 1 },
+   { "action", "The action", 11 },
+   { "mode", "Mode char", 12 },
+   // Your Invitation
+   { "nick", "Nick of person who have been invited", 1 },
+   { "name", "Channel Name", 42 },
+   { "server", "Server Name", 43 },
+   // Your Message
+   { "nick", "Nickname", 1 },
+   { "text", "The text", 18 },
+   { "mode", "Mode char", 12 },
+   { "idText", "Identified text", 54 },
+   // Your Nick Changing
+   { "nick", "Old nickname", 1 },
+   { "newnick", "New nickname", 10 },
+};
+
+// sorted by name, case insensitive
+static const EventDesc s_events[] = {
+   { "Add Notify", { s_eventParams + 0, 1 } },
+   { "Ban List", { s_eventParams + 1, 4 } },
+   { "Banned", { s_eventParams + 5, 1 } },
+   { "Beep", { s_eventParams + 6, 0 } },
+   { "Change Nick", { s_eventParams + 6, 2 } },
+   { "Channel Action", { s_eventParams + 8, 3 } },
+   { "Channel Action Hilight", { s_eventParams + 11, 3 } },
+   { "Channel Ban", { s_eventParams + 14, 2 } },
+   { "Channel Creation", { s_eventParams + 16, 2 } },
+   { "Channel DeHalfOp", { s_eventParams + 18, 2 } },
+   { "Channel DeOp", { s_eventParams + 20, 2 } },
+   { "Channel DeVoice", { s_eventParams + 22, 2 } },
+   { "Channel Exempt", { s_eventParams + 24, 2 } },
+   { "Channel Half-Operator", { s_eventParams + 26, 2 } },
+   { "Channel INVITE", { s_eventParams + 28, 2 } },
+   { "Channel List", { s_eventParams + 30, 0 } },
+   { "Channel Message", { s_eventParams + 30, 4 } },
+   { "Channel Mode Generic", { s_eventParams + 34, 4 } },
+   { "Channel Modes", { s_eventParams + 38, 2 } },
+   { "Channel Msg Hilight", { s_eventParams + 40, 4 } },
+   { "Channel Notice", { s_eventParams + 44, 3 } },
+   { "Channel Operator", { s_eventParams + 47, 2 } },
+   { "Channel Remove Exempt", { s_eventParams + 49, 2 } },
+   { "Channel Remove Invite", { s_eventParams + 51, 2 } },
+   { "Channel Remove Keyword", { s_eventParams + 53, 1 } },
+   { "Channel Remove Limit", { s_eventParams + 54, 1 } },
+   { "Channel Set Key", { s_eventParams + 55, 2 } },
+   { "Channel Set Limit", { s_eventParams + 57, 2 } },
+   { "Channel UnBan", { s_eventParams + 59, 2 } },
+   { "Channel Voice", { s_eventParams + 61, 2 } },
+   { "Close Context", { s_eventParams + 63, 0 } },
+   { "Connected", { s_eventParams + 63, 0 } },
+   { "Connecting", { s_eventParams + 63, 3 } },
+   { "Connection Failed", { s_eventParams + 66, 1 } },
+   { "CTCP Generic", { s_eventParams + 67, 2 } },
+   { "CTCP Generic to Channel", { s_eventParams + 69, 3 } },
+   { "CTCP Send", { s_eventParams + 72, 2 } },
+   { "CTCP Sound", { s_eventParams + 74, 2 } },
+   { "CTCP Sound to Channel", { s_eventParams + 76, 3 } },
+   { "DCC CHAT Abort", { s_eventParams + 79, 1 } },
+   { "DCC CHAT Connect", { s_eventParams + 80, 2 } },
+   { "DCC CHAT Failed", { s_eventParams + 82, 4 } },
+   { "DCC CHAT Offer", { s_eventParams + 86, 1 } },
+   { "DCC CHAT Offering", { s_eventParams + 87, 1 } },
+   { "DCC CHAT Reoffer", { s_eventParams + 88, 1 } },
+   { "DCC Chat Text", { s_eventParams + 89, 4 } },
+   { "DCC Conection Failed", { s_eventParams + 93, 3 } },
+   { "DCC Generic Offer", { s_eventParams + 96, 2 } },
+   { "DCC Header", { s_eventParams + 98, 0 } },
+   { "DCC Malformed", { s_eventParams + 98, 2 } },
+   { "DCC Offer", { s_eventParams + 100, 3 } },
+   { "DCC Offer Not Valid", { s_eventParams + 103, 0 } },
+   { "DCC RECV Abort", { s_eventParams + 103, 2 } },
+   { "DCC RECV Complete", { s_eventParams + 105, 4 } },
+   { "DCC RECV Connect", { s_eventParams + 109, 3 } },
+   { "DCC RECV Failed", { s_eventParams + 112, 4 } },
+   { "DCC RECV File Open Error", { s_eventParams + 116, 2 } },
+   { "DCC Rename", { s_eventParams + 118, 2 } },
+   { "DCC RESUME Request", { s_eventParams + 120, 3 } },
+   { "DCC SEND Abort", { s_eventParams + 123, 2 } },
+   { "DCC SEND Complete", { s_eventParams + 125, 3 } },
+   { "DCC SEND Connect", { s_eventParams + 128, 3 } },
+   { "DCC SEND Failed", { s_eventParams + 131, 3 } },
+   { "DCC SEND Offer", { s_eventParams + 134, 4 } },
+   { "DCC Stall", { s_eventParams + 138, 3 } },
+   { "DCC Timeout", { s_eventParams + 141, 3 } },
+   { "Delete Notify", { s_eventParams + 144, 1 } },
+   { "Disconnected", { s_eventParams + 145, 1 } },
+   { "Focus Tab", { s_eventParams + 146, 0 } },
+   { "Focus Window", { s_eventParams + 146, 0 } },
+   { "Found IP", { s_eventParams + 146, 1 } },
+   { "Generic Message", { s_eventParams + 147, 2 } },
+   { "Ignore Add", { s_eventParams + 149, 1 } },
+   { "Ignore Changed", { s_eventParams + 150, 1 } },
+   { "Ignore Footer", { s_eventParams + 151, 0 } },
+   { "Ignore Header", { s_eventParams + 151, 0 } },
+   { "Ignore Remove", { s_eventParams + 151, 1 } },
+   { "Ignorelist Empty", { s_eventParams + 152, 0 } },
+   { "Invite", { s_eventParams + 152, 1 } },
+   { "Invited", { s_eventParams + 153, 3 } },
+   { "Join", { s_eventParams + 156, 3 } },
+   { "Key Press", { s_eventParams + 159, 4 } },
+   { "Keyword", { s_eventParams + 163, 1 } },
+   { "Kick", { s_eventParams + 164, 4 } },
+   { "Killed", { s_eventParams + 168, 2 } },
+   { "Message Send", { s_eventParams + 170, 2 } },
+   { "Motd", { s_eventParams + 172, 2 } },
+   { "MOTD Skipped", { s_eventParams + 174, 0 } },
+   { "Nick Clash", { s_eventParams + 174, 2 } },
+   { "Nick Failed", { s_eventParams + 176, 0 } },
+   { "No DCC", { s_eventParams + 176, 0 } },
+   { "No Running Process", { s_eventParams + 176, 0 } },
+   { "Notice", { s_eventParams + 176, 2 } },
+   { "Notice Send", { s_eventParams + 178, 2 } },
+   { "Notify Empty", { s_eventParams + 180, 0 } },
+   { "Notify Header", { s_eventParams + 180, 0 } },
+   { "Notify Number", { s_eventParams + 180, 1 } },
+   { "Notify Offline", { s_eventParams + 181, 3 } },
+   { "Notify Online", { s_eventParams + 184, 3 } },
+   { "Open Context", { s_eventParams + 187, 0 } },
+   { "Open Dialog", { s_eventParams + 187, 0 } },
+   { "Part", { s_eventParams + 187, 3 } },
+   { "Part with Reason", { s_eventParams + 190, 4 } },
+   { "Ping Reply", { s_eventParams + 194, 2 } },
+   { "Ping Timeout", { s_eventParams + 196, 1 } },
+   { "Private Message", { s_eventParams + 197, 3 } },
+   { "Private Message to Dialog", { s_eventParams + 200, 3 } },
+   { "Process Already Running", { s_eventParams + 203, 0 } },
+   { "Quit", { s_eventParams + 203, 3 } },
+   { "Raw Modes", { s_eventParams + 206, 2 } },
+   { "Receive Wallops", { s_eventParams + 208, 2 } },
+   { "Resolving User", { s_eventParams + 210, 2 } },
+   { "Server Connected", { s_eventParams + 212, 0 } },
+   { "Server Error", { s_eventParams + 212, 1 } },
+   { "Server Lookup", { s_eventParams + 213, 1 } },
+   { "Server Notice", { s_eventParams + 214, 2 } },
+   { "Server Text", { s_eventParams + 216, 2 } },
+   { "Stop Connection", { s_eventParams + 218, 0 } },
+   { "Topic", { s_eventParams + 218, 2 } },
+   { "Topic Change", { s_eventParams + 220, 3 } },
+   { "Topic Creation", { s_eventParams + 223, 3 } },
+   { "Unknown Host", { s_eventParams + 226, 0 } },
+   { "User Limit", { s_eventParams + 226, 1 } },
+   { "Users On Channel", { s_eventParams + 227, 2 } },
+   { "WhoIs Authenticated", { s_eventParams + 229, 3 } },
+   { "WhoIs Away Line", { s_eventParams + 232, 2 } },
+   { "WhoIs Channel/Oper Line", { s_eventParams + 234, 2 } },
+   { "WhoIs End", { s_eventParams + 236, 1 } },
+   { "WhoIs Identified", { s_eventParams + 237, 2 } },
+   { "WhoIs Idle Line", { s_eventParams + 239, 2 } },
+   { "WhoIs Idle Line with Signon", { s_eventParams + 241, 3 } },
+   { "WhoIs Name Line", { s_eventParams + 244, 4 } },
+   { "WhoIs Real Host", { s_eventParams + 248, 4 } },
+   { "WhoIs Server Line", { s_eventParams + 252, 2 } },
+   { "WhoIs Special", { s_eventParams + 254, 2 } },
+   { "You Join", { s_eventParams + 256, 3 } },
+   { "You Kicked", { s_eventParams + 259, 4 } },
+   { "You Part", { s_eventParams + 263, 3 } },
+   { "You Part with Reason", { s_eventParams + 266, 4 } },
+   { "Your Action", { s_eventParams + 270, 3 } },
+   { "Your Invitation", { s_eventParams + 273, 3 } },
+   { "Your Message", { s_eventParams + 276, 4 } },
+   { "Your Nick Changing", { s_eventParams + 280, 2 } },
+};
+static const int s_eventCount = 143;
+
+// perfect hash: index = slots[ hash( disp[ hash( 0, name ) & mask ], name ) & mask ]
+static const unsigned int s_eventHashMask = 255;
+
+static const unsigned int s_eventHashDisp[] = {
+   1, 0, 0, 2, 1, 1, 2, 0, 0, 1, 0, 0,
+   0, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0,
+   0, 0, 1, 1, 2, 1, 2, 0, 0, 1, 0, 0,
+   1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 2,
+   2, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0,
+   0, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 0,
+   0, 0, 2, 0, 1, 2, 0, 0, 1, 0, 1, 0,
+   0, 1, 1, 3, 0, 0, 0, 1, 1, 0, 0, 2,
+   0, 0, 1, 3, 0, 1, 0, 0, 1, 2, 0, 1,
+   4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 1, 0, 2, 1, 0, 0, 1, 2, 1, 0,
+   1, 1, 0, 1, 0, 2, 0, 1, 5, 0, 4, 0,
+   2, 0, 0, 0, 3, 4, 1, 3, 0, 2, 0, 0,
+   1, 0, 0, 7, 3, 0, 0, 0, 4, 0, 0, 0,
+   1, 0, 0, 1, 2, 0, 0, 0, 0, 1, 0, 0,
+   2, 0, 0, 0, 0, 3, 0, 0, 0, 1, 0, 3,
+   0, 0, 0, 0, 3, 0, 1, 0, 1, 0, 0, 0,
+   2, 2, 0, 0, 0, 3, 3, 2, 0, 0, 0, 1,
+   1, 0, 0, 0, 1, 2, 2, 1, 0, 0, 3, 2,
+   0, 1, 0, 0, 3, 0, 1, 0, 1, 0, 0, 3,
+   0, 1, 5, 3, 0, 0, 0, 0, 0, 1, 0, 0,
+   1, 1, 0, 0,
+};
+
+static const short s_eventHashSlot[] = {
+   57, 95, -1, 38, 56, -1, 5, -1, -1, -1, -1, 139,
+   -1, 20, 46, 72, 127, 106, -1, -1, -1, -1, 25, -1,
+   -1, 119, -1, -1, 30, -1, -1, 21, 133, 2, 107, -1,
+   -1, -1, 3, 83, 6, 60, 41, 0, -1, 50, -1, -1,
+   -1, -1, 116, -1, -1, 34, 80, -1, -1, -1, 97, -1,
+   27, 8, 123, 54, 75, -1, 67, -1, -1, 23, -1, 90,
+   102, 32, -1, 42, -1, -1, -1, 140, 65, 59, 15, -1,
+   52, -1, 96, -1, 84, -1, 24, 49, 87, -1, -1, 109,
+   135, -1, -1, 104, 44, -1, -1, -1, -1, 85, 58, -1,
+   45, -1, 39, -1, 68, 124, 17, -1, -1, -1, -1, 4,
+   86, -1, 131, 128, 11, 16, -1, -1, -1, -1, 137, 19,
+   -1, 37, -1, 120, 100, 51, 28, 141, 63, -1, -1, -1,
+   -1, 81, -1, -1, -1, 122, 110, -1, -1, -1, -1, 9,
+   70, -1, 105, -1, 14, 126, 130, 69, 113, 79, 138, 92,
+   134, -1, 7, 36, 22, 10, 31, 82, 1, 40, -1, -1,
+   -1, 114, -1, 94, 76, 78, 93, -1, -1, 99, 89, -1,
+   98, -1, 74, 103, 118, -1, 91, -1, -1, -1, 18, 61,
+   -1, -1, -1, 117, -1, -1, 53, 55, -1, 71, 26, 29,
+   -1, -1, 108, 33, 101, -1, -1, 142, -1, -1, -1, 43,
+   66, -1, 88, 12, 35, 125, -1, -1, 77, 13, 48, 112,
+   129, 115, -1, 73, 136, 111, -1, -1, -1, 62, 132, 64,
+   -1, 47, -1, 121,
+};
+
+//==============================================
+// Server messages
+//
+
+static const ParamDesc s_srvmsgParams[] = {
+   // 001
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "Welcome message", 15 },
+   // 002
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "Server name and version", 15 },
+   // 003
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "Server creation date", 15 },
+   // 004
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "server", "Server name", 43 },
+   { "version", "Server version", 69 },
+   { "usermodes", "Available user modes", 70 },
+   { "chanmodes", "Available channel modes", 71 },
+   // 301
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being away", 72 },
+   { "message", "Away message", 15 },
+   // 311
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "user", "User name", 63 },
+   { "host", "Host", 21 },
+   { "-", "Unused", -1 },
+   { "realname", "Real name", 73 },
+   // 312
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "server", "Server the nick is connected to", 43 },
+   { "info", "Server information", 65 },
+   // 313
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "message", "Operator status description", 15 },
+   // 315
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "mask", "Mask of the WHO query", 7 },
+   { "message", "End of list message", 15 },
+   // 317
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "idle", "Seconds of idle time", 61 },
+   { "signon", "Signon time (non standard)", 62 },
+   { "message", "Description of the fields", 15 },
+   // 318
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "message", "End of list message", 15 },
+   // 319
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick being queried", 72 },
+   { "channels", "Space separated channels, with membership prefixes", 74 },
+   // 322
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "users", "Count of visible users", 58 },
+   { "topic", "Channel topic", 56 },
+   // 323
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "End of list message", 15 },
+   // 324
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "mode", "Channel modes", 12 },
+   // 329
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "time", "Creation time (non standard)", 9 },
+   // 331
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "No topic message", 15 },
+   // 332
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "topic", "Channel topic", 56 },
+   // 333
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "setter", "Who set the topic", 75 },
+   { "time", "Time the topic was set (non standard)", 9 },
+   // 352
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel, or * if none", 6 },
+   { "user", "User name", 63 },
+   { "host", "Host", 21 },
+   { "server", "Server the nick is connected to", 43 },
+   { "subject", "Nick being listed", 72 },
+   { "flags", "H or G, plus operator and membership flags", 76 },
+   { "info", "Hop count and real name", 65 },
+   // 353
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "type", "Channel type: = public, * private, @ secret", 29 },
+   { "channel", "Channel name", 6 },
+   { "names", "Space separated nicks, with membership prefixes", 77 },
+   // 366
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "End of list message", 15 },
+   // 367
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "mask", "Mask used for ban", 7 },
+   { "banner", "Who set the ban (non standard)", 8 },
+   { "time", "Ban time (non standard)", 9 },
+   // 368
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "End of list message", 15 },
+   // 372
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "A line of the message of the day", 15 },
+   // 375
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "Start of the message of the day", 15 },
+   // 376
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "message", "End of the message of the day", 15 },
+   // 401
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick not found", 72 },
+   { "message", "Error message", 15 },
+   // 403
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel not found", 6 },
+   { "message", "Error message", 15 },
+   // 404
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 433
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "subject", "Nick already in use", 72 },
+   { "message", "Error message", 15 },
+   // 442
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 461
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "command", "Command lacking parameters", 78 },
+   { "message", "Error message", 15 },
+   // 471
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 473
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 474
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 475
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // 482
+   { "nick:all", "Server sending the reply", 67 },
+   { "event", "Numeric code of the reply", 0 },
+   { "target", "Nick receiving the reply", 68 },
+   { "channel", "Channel name", 6 },
+   { "message", "Error message", 15 },
+   // INVITE
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "invited", "Invited nick", 79 },
+   { "channel", "Channel where the nick is invited", 6 },
+   // JOIN
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "channel", "Joined channel", 6 },
+   // KICK
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "channel", "Channel where the nick is kicked", 6 },
+   { "kicked", "Kicked nick", 66 },
+   // MODE
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "target", "target of mode change", 68 },
+   { "mode", "set mode", 12 },
+   // NICK
+   { "nick:all", "Complete nickname of the user changing nick", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "newnick", "The new nickname", 10 },
+   // NOTIFY
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "target", "Nick or channel where the privmsg is headed", 68 },
+   { "message", "Sent message", 15 },
+   // PART
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "channel", "Parted channel", 6 },
+   { "reason", "Reason", 48 },
+   // PONG
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "entity", "Entity at the other end of the pong", 80 },
+   { "lag", "Lag string", 81 },
+   // PRIVMSG
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "target", "Nick or channel where the privmsg is headed", 68 },
+   { "message", "Sent message", 15 },
+   // SERVER
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "server", "Name of the remote server", 43 },
+   { "hopcount", "Hop count to reach the server", 82 },
+   { "info", "Extra server info", 65 },
+   // SQUIT
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "server", "Name of the remote server", 43 },
+   { "comment", "Hop count to reach the server", 83 },
+   // TOPIC
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "channel", "Channel where the topic is set", 6 },
+   { "topic", "The topic", 56 },
+   // USER
+   { "nick:all", "Complete nickname of the user", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "user", "User name", 63 },
+   { "host", "Host", 21 },
+   { "server", "Server name", 43 },
+   { "name", "Real user name", 42 },
+   // VERSION
+   { "nick:all", "Complete name of the entity sending the message", 67 },
+   { "event", "The name of the sent event", 0 },
+   { "mask", "Mask used for versioning", 7 },
+};
+
+// sorted by name, case insensitive
+static const EventDesc s_srvmsgs[] = {
+   { "001", { s_srvmsgParams + 0, 4 } },
+   { "002", { s_srvmsgParams + 4, 4 } },
+   { "003", { s_srvmsgParams + 8, 4 } },
+   { "004", { s_srvmsgParams + 12, 7 } },
+   { "301", { s_srvmsgParams + 19, 5 } },
+   { "311", { s_srvmsgParams + 24, 8 } },
+   { "312", { s_srvmsgParams + 32, 6 } },
+   { "313", { s_srvmsgParams + 38, 5 } },
+   { "315", { s_srvmsgParams + 43, 5 } },
+   { "317", { s_srvmsgParams + 48, 7 } },
+   { "318", { s_srvmsgParams + 55, 5 } },
+   { "319", { s_srvmsgParams + 60, 5 } },
+   { "322", { s_srvmsgParams + 65, 6 } },
+   { "323", { s_srvmsgParams + 71, 4 } },
+   { "324", { s_srvmsgParams + 75, 5 } },
+   { "329", { s_srvmsgParams + 80, 5 } },
+   { "331", { s_srvmsgParams + 85, 5 } },
+   { "332", { s_srvmsgParams + 90, 5 } },
+   { "333", { s_srvmsgParams + 95, 6 } },
+   { "352", { s_srvmsgParams + 101, 10 } },
+   { "353", { s_srvmsgParams + 111, 6 } },
+   { "366", { s_srvmsgParams + 117, 5 } },
+   { "367", { s_srvmsgParams + 122, 7 } },
+   { "368", { s_srvmsgParams + 129, 5 } },
+   { "372", { s_srvmsgParams + 134, 4 } },
+   { "375", { s_srvmsgParams + 138, 4 } },
+   { "376", { s_srvmsgParams + 142, 4 } },
+   { "401", { s_srvmsgParams + 146, 5 } },
+   { "403", { s_srvmsgParams + 151, 5 } },
+   { "404", { s_srvmsgParams + 156, 5 } },
+   { "433", { s_srvmsgParams + 161, 5 } },
+   { "442", { s_srvmsgParams + 166, 5 } },
+   { "461", { s_srvmsgParams + 171, 5 } },
+   { "471", { s_srvmsgParams + 176, 5 } },
+   { "473", { s_srvmsgParams + 181, 5 } },
+   { "474", { s_srvmsgParams + 186, 5 } },
+   { "475", { s_srvmsgParams + 191, 5 } },
+   { "482", { s_srvmsgParams + 196, 5 } },
+   { "INVITE", { s_srvmsgParams + 201, 4 } },
+   { "JOIN", { s_srvmsgParams + 205, 3 } },
+   { "KICK", { s_srvmsgParams + 208, 4 } },
+   { "MODE", { s_srvmsgParams + 212, 4 } },
+   { "NICK", { s_srvmsgParams + 216, 3 } },
+   { "NOTIFY", { s_srvmsgParams + 219, 4 } },
+   { "PART", { s_srvmsgParams + 223, 4 } },
+   { "PONG", { s_srvmsgParams + 227, 4 } },
+   { "PRIVMSG", { s_srvmsgParams + 231, 4 } },
+   { "SERVER", { s_srvmsgParams + 235, 5 } },
+   { "SQUIT", { s_srvmsgParams + 240, 4 } },
+   { "TOPIC", { s_srvmsgParams + 244, 4 } },
+   { "USER", { s_srvmsgParams + 248, 6 } },
+   { "VERSION", { s_srvmsgParams + 254, 3 } },
+};
+static const int s_srvmsgCount = 52;
+
+// perfect hash: index = slots[ hash( disp[ hash( 0, name ) & mask ], name ) & mask ]
+static const unsigned int s_srvmsgHashMask = 63;
+
+static const unsigned int s_srvmsgHashDisp[] = {
+   3, 0, 1, 1, 0, 1, 0, 0, 0, 1, 1, 1,
+   2, 1, 2, 0, 8, 1, 1, 0, 0, 0, 1, 2,
+   0, 8, 0, 1, 0, 1, 2, 15, 0, 0, 0, 0,
+   1, 0, 1, 2, 0, 0, 3, 0, 1, 0, 0, 4,
+   1, 2, 5, 0, 0, 0, 0, 0, 2, 1, 2, 19,
+   2, 4, 1, 1,
+};
+
+static const short s_srvmsgHashSlot[] = {
+   -1, 18, 14, 28, 20, -1, 29, 44, 22, 31, 50, 10,
+   43, 19, 13, -1, 40, 23, 37, 51, -1, 33, 46, -1,
+   34, 12, -1, 36, 0, 42, 35, 21, 49, -1, 32, 3,
+   9, 27, 2, 17, 7, 25, 11, -1, -1, 4, 47, 5,
+   8, 1, -1, 16, 41, 26, 39, 6, 45, 38, -1, -1,
+   24, 48, 30, 15,
+};
+
+/* end of fxchat_evtable.h */
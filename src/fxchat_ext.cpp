@@ -33,7 +33,15 @@
 #include "fxchat_hook.h"
 #include "fxchat_ext.h"
 #include "fxchat_events.h"
+#include "fxchat_mem.h"
+#include "fxchat_gc.h"
+#include "fxchat_output.h"
+#include "fxchat_context.h"
 #include "fxchat_vm.h"
+#include "fxchat_lazyevt.h"
+#include "fxchat_dispatch.h"
+#include "fxchat_batch.h"
+#include "fxchat_prefix.h"
 
 #include "version.h"
 
@@ -99,6 +107,8 @@ FALCON_FUNC  XChat_command( ::Falcon::VMachine *vm )
    }
 
    AutoCString ret( vm, *i_param );
+   // the command may print.
+   FlushOutput();
    xchat_command( the_plugin, ret );
 }
 
@@ -134,6 +144,8 @@ FALCON_FUNC  XChat_message( ::Falcon::VMachine *vm )
 
    String temp = "PRIVMSG " + *i_channel->asString() + " : " + *i_message->asString();
    AutoCString ret( vm, &temp );
+   // the command may print.
+   FlushOutput();
    xchat_command( the_plugin, ret.c_str() );
 }
 
@@ -186,6 +198,7 @@ FALCON_FUNC  XChat_emit( ::Falcon::VMachine *vm )
    }
    args[ count ] = 0;
 
+   FlushOutput();
    bool val = xchat_emit_print( the_plugin,
       args[0], args[1], args[2], args[3], args[4],
       args[5], args[6], args[7], args[8], args[9],
@@ -279,18 +292,35 @@ FALCON_FUNC  XChat_sendModes( ::Falcon::VMachine *vm )
 
 static void internal_create_context( VMachine *vm, xchat_context *ptr, const char *server, const char *channel )
 {
-   // Access the script data for faster retrival of the live-module
+   // the script may still have an instance for this context.
    XChatVM *xvm = static_cast<XChatVM *>( vm );
+   CoreObject *object = xvm->contexts().find( ptr );
+   if ( object != 0 )
+   {
+      // the names of query and server tabs change; keep up with the fresh ones.
+      if ( server != 0 )
+         object->setProperty( "server", FastUTF8String( server ) );
+      if ( channel != 0 )
+         object->setProperty( "channel", FastUTF8String( channel ) );
+
+      vm->retval( object );
+      return;
+   }
 
    // create an instance of the private class XChatContext
-   Item *clitem = xvm->scriptData()->m_liveModule->findModuleItem( "XChatContext" );
+   Item *clitem = xvm->scriptData()->m_ctxClass;
    fassert( clitem != 0 );
 
    // Create the core object
-   CoreObject *object = clitem->asClass()->createInstance();
-   object->setUserData( ptr );
+   object = clitem->asClass()->createInstance();
+   ContextCarrier *carrier = new ContextCarrier( ptr );
+   object->setUserData( carrier );
+   xvm->contexts().insert( carrier, object );
+
+   // fill the infos; the instance is kept, so they must be the ones of ptr.
+   xchat_context *oldCtx = CurrentContext();
+   bool switched = ( server == 0 || channel == 0 ) && SwitchContext( ptr );
 
-   // fill the infos
    if ( server == 0 ) {
       server = xchat_get_info( the_plugin, "server" );
       if ( server == 0 )
@@ -303,13 +333,46 @@ static void internal_create_context( VMachine *vm, xchat_context *ptr, const cha
          channel = "";
    }
 
-   object->setProperty( "server", UTF8String( server ) );
-   object->setProperty( "channel", UTF8String( channel ) );
+   object->setProperty( "server", FastUTF8String( server ) );
+   object->setProperty( "channel", FastUTF8String( channel ) );
+
+   if ( switched )
+      SwitchContext( oldCtx );
 
    vm->retval( object );
 
 }
 
+// Calls a script item with another context made current, restoring it then.
+static void internal_run_in_context( VMachine *vm, xchat_context *ctx, const Item &i_callable )
+{
+   xchat_context *oldCtx = CurrentContext();
+   if ( ! SwitchContext( ctx ) )
+   {
+      // the context has been closed.
+      vm->retnil();
+      return;
+   }
+
+   // a suspended call would be resumed after the context is restored.
+   XChatVM *xvm = static_cast<XChatVM *>( vm );
+   xvm->enterNoBreak();
+
+   try {
+      vm->callItem( i_callable, 0 );
+   }
+   catch( Error * )
+   {
+      xvm->leaveNoBreak();
+      SwitchContext( oldCtx );
+      throw;
+   }
+
+   // the return value of the item is left in A.
+   xvm->leaveNoBreak();
+   SwitchContext( oldCtx );
+}
+
 /*#
    @method findContext XChat
    @brief Finds an xchat context matching the given name.
@@ -381,8 +444,8 @@ FALCON_FUNC  XChat_findContext( ::Falcon::VMachine *vm )
    This method returns the currently open context (XChat window or tab) in a
    @a XChatContext instance.
 
-   @note Possibly, record this value for later usage; avoid recreating it too often,
-   if not necessary, as creating instances requires extra memory allocation.
+   The same instance is returned for the same context, as long as the script
+   keeps it and the context is open.
 */
 FALCON_FUNC  XChat_getContext( ::Falcon::VMachine *vm )
 {
@@ -435,7 +498,7 @@ FALCON_FUNC  XChat_getInfo( ::Falcon::VMachine *vm )
    if( info == 0 )
       vm->retnil();
    else {
-      vm->retval( UTF8String( info ) );
+      vm->retval( FastUTF8String( info ) );
    }
 }
 
@@ -471,7 +534,7 @@ FALCON_FUNC  XChat_getPrefs( ::Falcon::VMachine *vm )
    switch( result )
    {
       case 0: vm->retnil(); break;
-      case 1: vm->retval( UTF8String( string ) ); break;
+      case 1: vm->retval( FastUTF8String( string ) ); break;
       case 2: vm->retval( (int64) value ); break;
       case 3: vm->regA().setBoolean( value != 0 ); break;
    }
@@ -552,11 +615,55 @@ FALCON_FUNC  XChat_strip( ::Falcon::VMachine *vm )
       vm->retnil();
    }
    else {
-      vm->retval( UTF8String( returned ) );
+      vm->retval( FastUTF8String( returned ) );
       xchat_free( the_plugin, returned );
    }
 }
 
+/*#
+   @method parsePrefix XChat
+   @brief Splits the sender of an IRC message in nick, user and host.
+   @param prefix The sender, in the form nick!user\@host.
+   @return An array with the nick, the user and the host.
+
+   The prefix may start with the ":" found in raw IRC lines, and the scan
+   stops at the first blank, so that a whole raw line can be passed.
+   The user and the host parts are nil if not present; this is the case of
+   server names, that are returned as the nick.
+
+   @code
+      nick, user, host = XChat.parsePrefix( "jonnymind!~jm\@example.com" )
+   @endcode
+*/
+
+FALCON_FUNC  XChat_parsePrefix( ::Falcon::VMachine *vm )
+{
+   Item *i_prefix = vm->param( 0 );
+   if( i_prefix == 0 || ! i_prefix->isString() )
+   {
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).extra( "S" ) );
+      return;
+   }
+
+   AutoCString source( *i_prefix->asString() );
+   IrcPrefix prefix( source.c_str() );
+
+   CoreArray *parts = new CoreArray( 3 );
+   parts->append( prefix.nickString() );
+
+   if ( prefix.hasUser() )
+      parts->append( prefix.userString() );
+   else
+      parts->append( Item() );
+
+   if ( prefix.hasHost() )
+      parts->append( prefix.hostString() );
+   else
+      parts->append( Item() );
+
+   vm->retval( parts );
+}
+
 
 static void internal_crate_timestamp( VMachine *vm, time_t t )
 {
@@ -614,7 +721,7 @@ static void internal_list( VMachine *vm, const char *name )
          {
          case 's':
             vstr = xchat_list_str( the_plugin, list, (char*)fld );
-            value = UTF8String( vstr != 0 ? vstr : "" );
+            value = FastUTF8String( vstr != 0 ? vstr : "" );
             // is this the server or the channel? -- we must save it for the context
             if( strcmp( fld, "server" ) == 0 )
                server = vstr;
@@ -662,11 +769,11 @@ static void internal_list( VMachine *vm, const char *name )
             }
 
             // no need to bufferize.
-            dict->put( new CoreString( "context" ), vm->regA()  );
+            dict->put( static_cast<XChatVM *>( vm )->key( KEY_CONTEXT ), vm->regA()  );
             ctx = 0;
          }
          else {
-            dict->put( UTF8String( fld ), value );
+            dict->put( FastUTF8String( fld ), value );
          }
       }
 
@@ -847,37 +954,68 @@ FALCON_FUNC  XChat_list( ::Falcon::VMachine *vm )
 //=============================================================
 
 
-static void create_wordlist( VMachine *vm, LinearDict *eventInfo, char *word[], int cmdPos )
+static void create_wordlist( XChatVM *vm, LinearDict *eventInfo, char *word[], int cmdPos )
 {
    // if we're parsing a print event, we must find a print definition.
    CoreArray *theArray = new CoreArray;
 
    while( word[ cmdPos ][0] != 0 )
    {
-      theArray->append( UTF8String( word[ cmdPos ] ) );
+      theArray->append( FastUTF8String( word[ cmdPos ] ) );
       cmdPos ++;
    }
 
-   eventInfo->put( new CoreString( "wordlist" ), theArray  );
+   eventInfo->put( vm->key( KEY_WORDLIST ), theArray  );
 }
 
 
+// A suspended VM can't be called until it's resumed; the callers check
+// this before pushing the parameters, and skip the event.
+static bool internal_suspended( XChatHook *hook )
+{
+   return hook->owner()->isSleeping();
+}
+
 // Preforms the real call to the VM item performing the callback
 // Also appends to the already prepared parameters the parameterse passed by the
 // hook caller (at script level).
-static int internal_call_cb( XChatVM *vm, CoreObject *handler, const Item &i_callback, int paramCount )
+// If the callback received a lazy event, it is detached from the xchat
+// data as soon as the call is complete.
+static int internal_call_cb( XChatVM *vm, CoreObject *handler, const Item &i_callback, int paramCount,
+      LazyEvent *evt = 0 )
 {
+   // in a shared VM, the hook tells which script is running.
+   ScriptData *owner = static_cast<XChatHook *>( handler->getUserData() )->owner();
+   vm->scriptData( owner );
+   MemScope scope( vm->memAccount() );
+   OutputBurst burst;
+   NoteScriptActivity();
+   vm->startSlice();
+
    // the real call.
    try {
       vm->callItem( i_callback, paramCount );
+
+      // the call has been interrupted.
+      if ( vm->memAccount()->overLimit() )
+      {
+         vm->memAccount()->clearOverLimit();
+         throw HeapLimitError( vm->memAccount() );
+      }
    }
    catch( Falcon::Error* err )
    {
-      XChatErrHand::handleError( err, vm->scriptData() );
+      if ( evt != 0 )
+         evt->detach();
+
+      XChatErrHand::handleError( err, owner );
       return XCHAT_EAT_NONE;
    }
+
+   if ( evt != 0 )
+      evt->detach();
    
-   if ( vm->scriptData()->isSleeping() )
+   if ( owner->isSleeping() )
    {
       return XCHAT_EAT_NONE;
    }
@@ -885,15 +1023,81 @@ static int internal_call_cb( XChatVM *vm, CoreObject *handler, const Item &i_cal
    int retval = (int) vm->regA().forceInteger();
 
    // was this our last dance?
-   if( vm->scriptData()->hooks()->length() == 0 )
+   if( owner->hooks()->length() == 0 )
    {
-      UnloadModule( vm->scriptData() );
-      // vm is destroyed by now, so don't use it anymore.
+      UnloadModule( owner );
+      // vm may be destroyed by now, so don't use it anymore.
    }
 
    return retval;
 }
 
+// Creates an XChatEvent instance wrapping the xchat words.
+static LazyEvent *internal_lazy_event( XChatVM *vm, const String &event, const ParamDescList *params,
+      bool bServer, char *word[], char *word_eol[] )
+{
+   Item *clitem = vm->xchatModule()->findModuleItem( "XChatEvent" );
+   fassert( clitem != 0 );
+
+   LazyEvent *evt = new LazyEvent( vm, event, params, bServer, word, word_eol );
+   CoreObject *object = clitem->asClass()->createInstance();
+   object->setUserData( evt );
+
+   vm->pushParameter( object );
+   return evt;
+}
+
+// Queues the event for batched delivery; the hook never eats batched events.
+static int internal_queue_event( XChatHook *hook, const String &event, const ParamDescList *params,
+      bool bServer, char *word[], char *word_eol[] )
+{
+   LazyEvent *evt = new LazyEvent( hook->owner()->m_vm, event, params, bServer, word, word_eol );
+   evt->detach();
+   hook->batch()->push( evt );
+   return XCHAT_EAT_NONE;
+}
+
+void DeliverBatch( XChatHook *hook, LazyEvent **events, int count )
+{
+   CoreObject *handler = hook->handler();
+   Item i_callback;
+   if ( ! handler->getProperty( "callback", i_callback ) || ! i_callback.isCallable() )
+   {
+      // the callback has been canceled in the meanwhile.
+      for( int i = 0; i < count; i++ )
+         delete events[i];
+      return;
+   }
+
+   XChatVM *vm = hook->owner()->m_vm;
+   MemScope scope( vm->memAccount() );
+   CoreArray *batch = new CoreArray( count );
+
+   if ( hook->lazy() )
+   {
+      Item *clitem = vm->xchatModule()->findModuleItem( "XChatEvent" );
+      fassert( clitem != 0 );
+
+      for( int i = 0; i < count; i++ )
+      {
+         CoreObject *object = clitem->asClass()->createInstance();
+         object->setUserData( events[i] );
+         batch->append( object );
+      }
+   }
+   else {
+      for( int i = 0; i < count; i++ )
+      {
+         batch->append( events[i]->toDict() );
+         delete events[i];
+      }
+   }
+
+   vm->pushParameter( batch );
+   // the return value is meaningless, as the events are gone.
+   internal_call_cb( vm, handler, i_callback, 1 );
+}
+
 //=============================================================
 // Main callback hooks
 //=============================================================
@@ -911,10 +1115,14 @@ extern "C" int script_hook_command_cb( char *word[], char *word_eol[], void *use
       return XCHAT_EAT_NONE; // allow someone else to process the message.
    }
 
+   if ( internal_suspended( hook ) )
+      return XCHAT_EAT_NONE;
+
    // commands require word[1] and word_eol + 2 to be passed as first and second parameter
    XChatVM *vm = hook->owner()->m_vm;
-   vm->pushParameter( UTF8String(  word[1] )  );
-   vm->pushParameter( UTF8String(  word_eol[2] )  );
+   MemScope scope( vm->memAccount() );
+   vm->pushParameter( FastUTF8String(  word[1] )  );
+   vm->pushParameter( FastUTF8String(  word_eol[2] )  );
 
    return internal_call_cb( vm, handler, i_callback, 2 );
 }
@@ -924,6 +1132,10 @@ extern "C" int script_hook_print_cb(char *word[], void *user_data)
 {
    XChatHook *hook = (XChatHook *) user_data;
 
+   // discard filtered events without bothering the VM
+   if ( hook->filter() != 0 && ! hook->filter()->match( word, 0 ) )
+      return XCHAT_EAT_NONE;
+
    CoreObject *handler = hook->handler();
    Item i_callback;
    if ( ! handler->getProperty( "callback", i_callback ) || ! i_callback.isCallable() )
@@ -932,21 +1144,35 @@ extern "C" int script_hook_print_cb(char *word[], void *user_data)
       return XCHAT_EAT_NONE; // allow someone else to process the message.
    }
 
+   if ( hook->batch() != 0 )
+      return internal_queue_event( hook, hook->match(), hook->params(), false, word, 0 );
+
+   if ( internal_suspended( hook ) )
+      return XCHAT_EAT_NONE;
+
    XChatVM *vm = hook->owner()->m_vm;
+   MemScope scope( vm->memAccount() );
+
+   if ( hook->lazy() )
+   {
+      LazyEvent *evt = internal_lazy_event( vm, hook->match(), hook->params(), false, word, 0 );
+      return internal_call_cb( vm, handler, i_callback, 1, evt );
+   }
 
    LinearDict *eventInfo = new LinearDict( 10 );
 
-   // see if it's a registered event
-   ParamMap::const_iterator paramIter = s_PMevent.find( hook->match() );
-   if ( paramIter != s_PMevent.end() )
+   // see if it's a registered event (resolved at hook time)
+   const ParamDescList *params = hook->params();
+   if ( params != 0 )
    {
-      ParamDescList::const_iterator liter = paramIter->second.begin();
+      ParamDescList::const_iterator liter = params->begin();
       int idWord = 1;
-      while( (liter != paramIter->second.end()) && (word[idWord] != 0 && word[idWord][0] != '\0') )
+      while( (liter != params->end()) && (word[idWord] != 0 && word[idWord][0] != '\0') )
       {
          const ParamDesc &pd = *liter;
-         eventInfo->put( new CoreString( pd.m_param ),
-               UTF8String( word[idWord] ) );
+         // skipped words have no key.
+         if ( pd.m_key >= 0 )
+            eventInfo->put( vm->key( pd.m_key ), FastUTF8String( word[idWord] ) );
          ++liter;
          ++idWord;
       }
@@ -958,7 +1184,7 @@ extern "C" int script_hook_print_cb(char *word[], void *user_data)
    }
 
    // Create the event name from what we know it should be
-   eventInfo->put( new CoreString( "event" ), new CoreString( hook->match() ) );
+   eventInfo->put( vm->key( KEY_EVENT ), new CoreString( hook->match() ) );
 
 
    // add the event info
@@ -967,9 +1193,11 @@ extern "C" int script_hook_print_cb(char *word[], void *user_data)
 }
 
 
-extern "C" int script_hook_server_cb(char *word[], char *word_eol[], void *user_data)
+int DeliverServerMessage( XChatHook *hook, const ServerMessage &msg )
 {
-   XChatHook *hook = (XChatHook *) user_data;
+   // discard filtered messages without bothering the VM
+   if ( hook->filter() != 0 && ! hook->filter()->match( msg ) )
+      return XCHAT_EAT_NONE;
 
    CoreObject *handler = hook->handler();
    Item i_callback;
@@ -979,73 +1207,60 @@ extern "C" int script_hook_server_cb(char *word[], char *word_eol[], void *user_
       return XCHAT_EAT_NONE; // allow someone else to process the message.
    }
 
+   // hooks on numeric ranges report the actual reply code
+   String code( hook->numeric() && msg.wordCount() > 2 ? msg.word()[2] : "" );
+   const String *event = code.size() != 0 ? &code : &hook->match();
+
+   if ( hook->batch() != 0 )
+      return internal_queue_event( hook, *event, msg.params(), true, msg.word(), msg.word_eol() );
+
+   if ( internal_suspended( hook ) )
+      return XCHAT_EAT_NONE;
+
    XChatVM *vm = hook->owner()->m_vm;
+   MemScope scope( vm->memAccount() );
+
+   if ( hook->lazy() )
+   {
+      LazyEvent *evt = internal_lazy_event( vm, *event, msg.params(), true, msg.word(), msg.word_eol() );
+      return internal_call_cb( vm, handler, i_callback, 1, evt );
+   }
+
    LinearDict *eventInfo = new LinearDict( 10 );
 
-   // Seek the proper event
-   ParamMap::const_iterator paramIter = s_PMsrvmsg.find( hook->match() );
-   if ( paramIter != s_PMsrvmsg.end() )
+   // The message has already been split in the fields of its plan
+   const ParamDescList *params = msg.params();
+   if ( params != 0 )
    {
       // great, create the matched data
       // don't store the event, as it's the second element.
 
-      ParamDescList::const_iterator liter = paramIter->second.begin();
-      int idWord = 1;
-      bool bDone = false;
-
-      while( ! bDone && liter != paramIter->second.end() && word[idWord] != 0 && word[idWord][0] != '\0' )
+      // Have we a nick in the first element?
+      const IrcPrefix &prefix = msg.prefix();
+      if ( msg.fieldCount() > 0 && prefix.isUser() )
       {
-         const ParamDesc &pd = *liter;
-         const char *curWord = word[idWord];
-         String *current;
-
-         // special processing for first element, which may be a supernick
-         if ( idWord == 1 )
-         {
-            // the first word generally contains an extra ":" at the beginning.
-            // strip it
-            uint32 start = curWord[ 0 ] == ':' ? 1 : 0;
-
-            current = UTF8String( curWord + start );
-            uint32 posBang = current->find( "!" );
-            uint32 posAt = current->find( "@", posBang );
-            // Have we a nick?
-            if ( posBang < current->length() && posAt < current->length() )
-            {
-               String *nick = new CoreString( current->subString( 0, posBang ) );
-               String *user = new CoreString( current->subString( posBang + 1, posAt ) );
-               String *server = new CoreString( current->subString( posAt + 1 ) );
-
-               eventInfo->put( new CoreString( "nick" ), nick  );
-               eventInfo->put( new CoreString( "nick:user" ), user  );
-               eventInfo->put( new CoreString( "nick:net" ), server  );
-            }
-         }
-         // in managed messages, a ":" beyond the first element means "all the reset".
-         else if ( curWord[0] == ':' )
-         {
-            current = UTF8String( word_eol[idWord] + 1 );
-            // this will be the last loop
-            bDone = true;
-         }
-         else {
-            // just create the entity
-            current = UTF8String( word[idWord] );
-         }
-
-         eventInfo->put( UTF8String( pd.m_param ), current );
+         eventInfo->put( vm->key( KEY_NICK ), prefix.nickString() );
+         if ( prefix.hasUser() )
+            eventInfo->put( vm->key( KEY_NICK_USER ), prefix.userString() );
+         if ( prefix.hasHost() )
+            eventInfo->put( vm->key( KEY_NICK_NET ), prefix.hostString() );
+      }
 
+      ParamDescList::const_iterator liter = params->begin();
+      for( int i = 0; i < msg.fieldCount(); i++ )
+      {
+         if ( liter->m_key >= 0 )
+            eventInfo->put( vm->key( liter->m_key ), FastUTF8String( msg.field( i ) ) );
          ++liter;
-         ++idWord;
       }
    }
    // If this is an unmanaged server message
    else {
       // Create the event name from what we know it should be
-      eventInfo->put( new CoreString( "event" ), new CoreString( hook->match(), -1 ) );
+      eventInfo->put( vm->key( KEY_EVENT ), new CoreString( *event, -1 ) );
 
       // create wordlist from everything we have
-      create_wordlist( vm, eventInfo, word, 1 );
+      create_wordlist( vm, eventInfo, msg.word(), 1 );
    }
 
    // add the event info
@@ -1072,10 +1287,37 @@ extern "C" int script_hook_timer_cb(void *user_data)
       return XCHAT_EAT_NONE; // allow someone else to process the message.
    }
 
+   // try again when the script has been resumed.
+   if ( internal_suspended( hook ) )
+   {
+      hook->timer()->start( TIMER_TICK_MSECS );
+      return 0;
+   }
+
    return internal_call_cb( hook->owner()->m_vm, handler, i_callback, 0 );
 }
 
 
+// Interval hooks stay in the wheel until they are released; the wheel
+// computes the next deadline from the previous one.
+extern "C" int script_hook_interval_cb(void *user_data)
+{
+   XChatHook *hook = (XChatHook *) user_data;
+   CoreObject *handler = hook->handler();
+
+   Item i_callback;
+   // a suspended script just misses the tick.
+   if ( ! internal_suspended( hook ) &&
+        handler->getProperty( "callback", i_callback ) && i_callback.isCallable() )
+   {
+      // an error or an unhook releases the hook, and with it the timer.
+      internal_call_cb( hook->owner()->m_vm, handler, i_callback, 0 );
+   }
+
+   return 1;
+}
+
+
 static void internal_hook( XChatHook *xhook,
                            Item *i_callable )
 {
@@ -1107,6 +1349,165 @@ static void internal_hook( XChatHook *xhook,
 }
 
 
+// Reads an entry of an options dictionary.
+static Item *internal_option( CoreDict *options, const char *name )
+{
+   String key( name );
+   return options->find( &key );
+}
+
+// Creates the native filter described by the "filter" option.
+// Returns false and fills the error string if the filter is invalid.
+static bool internal_hook_filter( VMachine *vm, XChatHook *xhook, bool bServer,
+      CoreDict *spec, String &error )
+{
+   HookFilter *filter = new HookFilter( bServer, xhook->params() );
+   xhook->filter( filter );
+
+   Item *i_target = internal_option( spec, "target" );
+   if ( i_target != 0 )
+   {
+      if ( i_target->isArray() )
+      {
+         CoreArray *targets = i_target->asArray();
+         for( uint32 i = 0; i < targets->length(); i++ )
+         {
+            AutoCString target( vm, targets->at( i ) );
+            if ( ! filter->addTarget( target ) )
+            {
+               error = "target";
+               return false;
+            }
+         }
+      }
+      else {
+         AutoCString target( vm, *i_target );
+         if ( ! filter->addTarget( target ) )
+         {
+            error = "target";
+            return false;
+         }
+      }
+   }
+
+   Item *i_nick = internal_option( spec, "nick" );
+   if ( i_nick != 0 )
+   {
+      AutoCString mask( vm, *i_nick );
+      if ( ! filter->nickMask( mask ) )
+      {
+         error = "nick";
+         return false;
+      }
+   }
+
+   Item *i_prefix = internal_option( spec, "prefix" );
+   if ( i_prefix != 0 )
+   {
+      AutoCString prefix( vm, *i_prefix );
+      if ( ! filter->prefix( prefix ) )
+      {
+         error = "prefix";
+         return false;
+      }
+   }
+
+   Item *i_contains = internal_option( spec, "contains" );
+   if ( i_contains != 0 )
+   {
+      AutoCString text( vm, *i_contains );
+      if ( ! filter->contains( text ) )
+      {
+         error = "contains";
+         return false;
+      }
+   }
+
+   Item *i_regex = internal_option( spec, "regex" );
+   if ( i_regex != 0 )
+   {
+      AutoCString expr( vm, *i_regex );
+      if ( ! filter->regex( expr ) )
+      {
+         error = "regex";
+         return false;
+      }
+   }
+
+   return true;
+}
+
+// Applies the options dictionary of hookPrint and hookServer.
+// Returns false and fills the error string if an option is invalid.
+static bool internal_hook_options( VMachine *vm, XChatHook *xhook, bool bServer,
+      Item *i_options, String &error )
+{
+   if ( i_options == 0 || ! i_options->isDict() )
+      return true;
+
+   CoreDict *options = i_options->asDict();
+
+   Item *i_lazy = internal_option( options, "lazy" );
+   if ( i_lazy != 0 )
+      xhook->lazy( i_lazy->isTrue() );
+
+   Item *i_priority = internal_option( options, "priority" );
+   if ( i_priority != 0 )
+   {
+      if ( ! i_priority->isOrdinal() )
+      {
+         error = "priority";
+         return false;
+      }
+      xhook->priority( (int) i_priority->forceInteger() );
+   }
+
+   Item *i_filter = internal_option( options, "filter" );
+   if ( i_filter != 0 )
+   {
+      if ( ! i_filter->isDict() )
+      {
+         error = "filter";
+         return false;
+      }
+
+      if ( ! internal_hook_filter( vm, xhook, bServer, i_filter->asDict(), error ) )
+         return false;
+   }
+
+   Item *i_batch = internal_option( options, "batch" );
+   Item *i_batchTime = internal_option( options, "batchTime" );
+   if ( i_batch != 0 )
+   {
+      if ( ! i_batch->isOrdinal() || i_batch->forceInteger() < 1 )
+      {
+         error = "batch";
+         return false;
+      }
+
+      int msecs = 1000;
+      if ( i_batchTime != 0 )
+      {
+         if ( ! i_batchTime->isOrdinal() || i_batchTime->forceInteger() < 1 )
+         {
+            error = "batchTime";
+            return false;
+         }
+         msecs = (int) i_batchTime->forceInteger();
+      }
+
+      xhook->batch( new EventBatch( xhook, (int) i_batch->forceInteger(), msecs ) );
+   }
+   else if ( i_batchTime != 0 )
+   {
+      error = "batchTime";
+      return false;
+   }
+
+   return true;
+}
+
+
 /*#
    @method hookCommand XChat
    @brief Registers a new XChat command with its handler.
@@ -1247,6 +1648,7 @@ FALCON_FUNC  XChat_hookCommand( ::Falcon::VMachine *vm )
    @brief Registers a new handler for XChat Print events.
    @param event The print event to be hooked.
    @param cb A Falcon callable item to be called back when the print event occurs.
+   @optparam options A dictionary of hook options.
    @return An instance of @a XChatHook controlling the callback hook.
 
    This method installs a print event handler that is called back when the print
@@ -1300,6 +1702,18 @@ FALCON_FUNC  XChat_hookCommand( ::Falcon::VMachine *vm )
    test_print: }
    @endcode
 
+   The @b options dictionary may contain the following keys:
+   - "lazy": if true, the callback receives an @a XChatEvent instance instead of
+     the @b data dictionary. The fields of the event are decoded only when the
+     script reads them.
+   - "filter": a dictionary of conditions that the event must satisfy for the
+     callback to be called. See @a XChat.hookServer for a description.
+   - "priority": the priority of this hook with respect to other hooks on the
+     same event (XCHAT_PRI_NORM by default).
+   - "batch": a number of events to be collected before calling the handler.
+     See @a XChat.hookServer for a description.
+   - "batchTime": maximum time in milliseconds an event is kept in the batch.
+
    See the description of @a XChat.hookCommand for more informations about the possible
    usage of sigmas and XChatHook handlers.
 */
@@ -1308,16 +1722,18 @@ FALCON_FUNC  XChat_hookPrint( ::Falcon::VMachine *vm )
    // Parameters:
    // 0 -- the print event << mandatory
    // 1 -- the callable << mandatory
+   // 2 -- the options << optional
 
    Item *i_cmd = vm->param( 0 );
    Item *i_callable = vm->param( 1 );
+   Item *i_options = vm->param( 2 );
 
    if ( i_cmd == 0 || ! i_cmd->isString() ||
       i_callable == 0 || ! i_callable->isCallable()
       )
    {
       throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).
-         extra( "S,C" ) );
+         extra( "S,C,[D]" ) );
       return;
    }
 
@@ -1326,9 +1742,19 @@ FALCON_FUNC  XChat_hookPrint( ::Falcon::VMachine *vm )
    // we can now hook the command to xchat
    xchat_hook *hook;
    XChatVM *xvm = static_cast<XChatVM *>( vm );
-   XChatHook *xhook = new XChatHook( xvm->scriptData(), *i_cmd->asString() );
+   XChatHook *xhook = new XChatHook( xvm->scriptData(), *i_cmd->asString(),
+         FindEventParams( *i_cmd->asString() ) );
+
+   String error;
+   if ( ! internal_hook_options( vm, xhook, false, i_options, error ) )
+   {
+      delete xhook;
+      throw  new ParamError( ErrorParam( e_param_range, __LINE__ ).
+         extra( "invalid option: " + error ) );
+      return;
+   }
 
-   hook = xchat_hook_print( the_plugin, cmd, XCHAT_PRI_NORM, script_hook_print_cb, xhook );
+   hook = xchat_hook_print( the_plugin, cmd, xhook->priority(), script_hook_print_cb, xhook );
 
    if ( hook == 0 )
    {
@@ -1346,6 +1772,7 @@ FALCON_FUNC  XChat_hookPrint( ::Falcon::VMachine *vm )
    @brief Registers a new handler for XChat server message.
    @param event The server event to be hooked.
    @param cb A Falcon callable item to be called back when the server message occurs.
+   @optparam options A dictionary of hook options.
    @return An instance of @a XChatHook controlling the callback hook.
 
    This method installs a server message handler that is called back when the specified
@@ -1400,6 +1827,95 @@ FALCON_FUNC  XChat_hookPrint( ::Falcon::VMachine *vm )
       test_server2: }
    @endcode
 
+   The @b options dictionary may contain the following keys:
+   - "lazy": if true, the callback receives an @a XChatEvent instance instead of
+     the @b data dictionary. Scripts that discard most of the messages after
+     checking one or two fields should use this option, as the other fields
+     are never decoded. In example:
+   @code
+      function onMessage( msg )
+         if msg["target"] != "#ops": return XCHAT_EAT_NONE
+         inspect( msg.toDict() )
+         return XCHAT_EAT_NONE
+      end
+
+      XChat.hookServer( "PRIVMSG", onMessage, [ "lazy" => true ] )
+   @endcode
+
+   - "filter": a dictionary of conditions that the message must satisfy for the
+     callback to be called. The conditions are checked by the plugin before
+     entering the script, and messages that don't match are passed through
+     as if the callback returned XCHAT_EAT_NONE. All the given conditions must
+     match:
+      - "target": a channel or nick name (or an array of them) that must be the
+        target of the message; it is checked against the "channel" field for
+        messages having no "target". The comparison is case insensitive.
+      - "nick": a mask with "*" and "?" wildcards that the sender must match.
+        If the mask contains "!" or "@" it is matched against the complete
+        sender (nick!user\@host), otherwise against the nickname only.
+      - "prefix": a string the "message" field must start with.
+      - "contains": a string that must appear in the "message" field, compared
+        case insensitively.
+      - "regex": a POSIX extended regular expression that must match the
+        "message" field.
+
+     Filters can only be applied to known messages having the required
+     fields. In example:
+   @code
+      XChat.hookServer( "PRIVMSG", onCommand,
+         [ "filter" => [ "target" => [ "#ops", "#staff" ], "prefix" => "!" ] ] )
+   @endcode
+
+   - "priority": the priority of this hook with respect to other hooks on the
+     same message (XCHAT_PRI_NORM by default).
+   - "batch": the number of messages to be collected before calling the handler.
+     Batched messages are stored by the plugin and delivered in a single call,
+     as an array of @b data dictionaries (or of @a XChatEvent instances if "lazy"
+     is also given). The hook never eats the messages, and the return value of
+     the handler is ignored; this is meant for logging and statistic scripts,
+     that can save a VM call per message.
+   - "batchTime": the maximum time, in milliseconds, a message can wait in the
+     batch before it's delivered (defaults to 1000). Requires "batch".
+   @code
+      function onMessages( msgs )
+         for msg in msgs: log.writeLine( msg["nick"] + ": " + msg["message"] )
+      end
+
+      XChat.hookServer( "PRIVMSG", onMessages, [ "batch" => 200, "batchTime" => 5000 ] )
+   @endcode
+   Messages still waiting in the batch when the hook is removed are discarded.
+
+   Numeric replies can be hooked by their code, as "353", or by a range of
+   codes, using "x" for the trailing digits: "3xx" hooks all the replies from
+   300 to 399, and "47x" those from 470 to 479. The most common RFC 1459/2812
+   replies are decoded in fields; use /FALCON HELP MESSAGES to list them. The
+   "event" field always holds the actual code of the reply, so that a single
+   handler can serve a whole range:
+   @code
+      function onReply( reply )
+         switch reply["event"]
+            case "352": > "Who: ", reply["subject"], " on ", reply["channel"]
+            case "315": > "End of who for ", reply["mask"]
+         end
+         return XCHAT_EAT_NONE
+      end
+
+      XChat.hookServer( "3xx", onReply )
+   @endcode
+   Filters on a range of numerics can only check the "nick" of the sender.
+
+   A single code is hooked in XChat as any other server message. Ranges are
+   dispatched through a table indexed by the code, fed by a single RAW LINE
+   hook at the priority of the most important range subscriber; as XChat
+   calls the RAW LINE hooks before the hooks on named messages, a range
+   handler sees the reply, and can eat it, before the handlers of the single
+   code, including those of other plugins.
+
+   All the scripts hooking the same server message share a single XChat hook;
+   the message is parsed once and then handed to each hook, from the highest
+   priority to the lowest. If a callback returns XCHAT_EAT_PLUGIN or XCHAT_EAT_ALL,
+   the hooks that follow are not called.
+
    See the description of @a XChat.hookCommand for more informations about the possible
    usage of sigmas and XChatHook handlers.
 */
@@ -1408,37 +1924,51 @@ FALCON_FUNC  XChat_hookServer( ::Falcon::VMachine *vm )
    // Parameters:
    // 0 -- the server event << mandatory
    // 1 -- the callable << mandatory
-   // 2...n extra parameters passed back to the handler
+   // 2 -- the options << optional
 
    Item *i_cmd = vm->param( 0 );
    Item *i_callable = vm->param( 1 );
+   Item *i_options = vm->param( 2 );
 
    if ( i_cmd == 0 || ! i_cmd->isString() ||
       i_callable == 0 || ! i_callable->isCallable()
       )
    {
       throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).
-         extra( "S,C" ) );
+         extra( "S,C,[D]" ) );
       return;
    }
 
-   AutoCString cmd( vm, *i_cmd );
+   // numeric ranges have no single parameter plan; a single code
+   // is hooked directly as any other server message.
+   const String &match = *i_cmd->asString();
+   int numFirst, numLast;
+   bool bNumeric = ParseNumericRange( match, numFirst, numLast ) && numFirst != numLast;
+   const ParamDescList *params = bNumeric ? 0 : FindSrvMsgParams( match );
 
    // we can now hook the command to xchat
-   xchat_hook *hook;
    XChatVM *xvm = static_cast<XChatVM *>( vm );
-   XChatHook *xhook = new XChatHook( xvm->scriptData(), *i_cmd->asString() );
+   XChatHook *xhook = new XChatHook( xvm->scriptData(), match, params );
+   if ( bNumeric )
+      xhook->numeric( numFirst, numLast );
 
-   hook = xchat_hook_server( the_plugin, cmd, XCHAT_PRI_NORM, script_hook_server_cb, xhook );
+   String error;
+   if ( ! internal_hook_options( vm, xhook, true, i_options, error ) )
+   {
+      delete xhook;
+      throw  new ParamError( ErrorParam( e_param_range, __LINE__ ).
+         extra( "invalid option: " + error ) );
+      return;
+   }
 
-   if ( hook == 0 )
+   // server messages are received through the shared dispatcher.
+   if ( ! SubscribeServer( xhook ) )
    {
       delete xhook;
       vm->retnil();
       return;
    }
 
-   xhook->hook( hook );
    internal_hook( xhook, i_callable );
 }
 
@@ -1480,23 +2010,94 @@ FALCON_FUNC  XChat_hookTimer( ::Falcon::VMachine *vm )
       return;
    }
 
-   // we can now hook the command to xchat
-   xchat_hook *hook;
+   // timers are kept in the plugin timer wheel, not in xchat.
    XChatVM *xvm = static_cast<XChatVM *>( vm );
    XChatHook *xhook = new XChatHook( xvm->scriptData(), "" );
-   hook = xchat_hook_timer( the_plugin, (int) (i_timeout->forceNumeric() * 1000), script_hook_timer_cb, xhook );
+   xhook->timer( new TimerEntry( script_hook_timer_cb, xhook ) );
+   xhook->timer()->start( (int64) (i_timeout->forceNumeric() * 1000) );
 
-   if ( hook == 0 )
+   internal_hook( xhook, i_callable );
+}
+
+
+/*#
+   @method hookInterval XChat
+   @brief Registers a handler called periodically.
+   @param interval Number of seconds and fractions of seconds between two calls.
+   @param cb A Falcon callable item to be called back at each expiration.
+   @return An instance of @a XChatHook controlling the callback hook.
+
+   This method installs a callback handler that will be called every @b interval
+   seconds, until the returned hook is removed with @a XChatHook.unhook.
+
+   Differently from @a XChat.hookTimer, the hook stays registered and is re-armed
+   by the plugin; the next expiration is computed from the previous one on a monotonic
+   clock, so the calls don't drift even if the callback takes some time. If the
+   plugin is late by more than one period, the missed calls are skipped.
+
+   The timing tolerance is of 10 milliseconds.
+*/
+FALCON_FUNC  XChat_hookInterval( ::Falcon::VMachine *vm )
+{
+   // Parameters:
+   // 0 -- the interval
+   // 1 -- the callable << mandatory
+
+   Item *i_interval = vm->param( 0 );
+   Item *i_callable = vm->param( 1 );
+
+   if ( i_interval == 0 || ! i_interval->isOrdinal() || i_interval->forceNumeric() <= 0.0 ||
+      i_callable == 0 || ! i_callable->isCallable() )
    {
-      delete xhook;
-      vm->retnil();
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).
+         extra( "N>0,C" ) );
       return;
    }
 
-   xhook->hook( hook );
+   XChatVM *xvm = static_cast<XChatVM *>( vm );
+   XChatHook *xhook = new XChatHook( xvm->scriptData(), "" );
+   xhook->timer( new TimerEntry( script_hook_interval_cb, xhook ) );
+   xhook->timer()->start( (int64) (i_interval->forceNumeric() * 1000) );
+
    internal_hook( xhook, i_callable );
 }
 
+/*#
+   @method inContext XChat
+   @brief Runs a function with a given context made current.
+   @param ctx An @a XChatContext instance.
+   @param func A Falcon callable item, called without parameters.
+   @return The value returned by @b func, or nil if the context has been closed.
+
+   While @b func runs, @b ctx is the current context: the output of the script,
+   and the methods of the XChat class acting on the current context, are directed to it.
+   The methods of @b ctx itself don't need to switch context.
+
+   This is a faster way to perform many operations on a context than calling
+   the methods of its @a XChatContext instance one by one, as each of them
+   switches to the context and back.
+
+   As the context must be restored when @b func returns, @b func can't call sleep(),
+   and it isn't suspended when it exceeds the execution budget of the script.
+
+   @see XChatContext.run
+*/
+FALCON_FUNC  XChat_inContext( ::Falcon::VMachine *vm )
+{
+   Item *i_ctx = vm->param( 0 );
+   Item *i_callable = vm->param( 1 );
+
+   if ( i_ctx == 0 || ! i_ctx->isObject() || ! i_ctx->asObject()->derivedFrom( "XChatContext" ) ||
+      i_callable == 0 || ! i_callable->isCallable() )
+   {
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).
+         extra( "XChatContext,C" ) );
+      return;
+   }
+
+   xchat_context *ctx = ObjectContext( i_ctx->asObject() );
+   internal_run_in_context( vm, ctx, *i_callable );
+}
 
 //==================================================
 // XChatContext class
@@ -1524,8 +2125,8 @@ FALCON_FUNC  XChat_hookTimer( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_set( ::Falcon::VMachine *vm )
 {
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
-   vm->retval( (int64) xchat_set_context( the_plugin, ctx ) );
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
+   vm->retval( (int64) SwitchContext( ctx ) );
 }
 
 /*#
@@ -1538,10 +2139,10 @@ FALCON_FUNC  XChatContext_set( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_print( ::Falcon::VMachine *vm )
 {
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       for( int i = 0; i < vm->paramCount(); i ++ )
       {
@@ -1559,7 +2160,7 @@ FALCON_FUNC  XChatContext_print( ::Falcon::VMachine *vm )
          }
       }
 
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 }
 
@@ -1576,13 +2177,13 @@ FALCON_FUNC  XChatContext_print( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_emit( ::Falcon::VMachine *vm )
 {
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       XChat_emit( vm );
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 }
 
@@ -1598,13 +2199,13 @@ FALCON_FUNC  XChatContext_emit( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_command( ::Falcon::VMachine *vm )
 {
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       XChat_command( vm );
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 }
 
@@ -1630,7 +2231,7 @@ FALCON_FUNC  XChatContext_message( ::Falcon::VMachine *vm )
    }
 
    CoreObject *self = vm->self().asObject();
-   xchat_context *ctx = (xchat_context *) self->getUserData();
+   xchat_context *ctx = ObjectContext( self );
 
    Item channel;
    self->getProperty( "channel", channel );
@@ -1638,6 +2239,8 @@ FALCON_FUNC  XChatContext_message( ::Falcon::VMachine *vm )
    {
       String temp = "PRIVMSG " + *channel.asString() + " : " + *i_message->asString();
       AutoCString ret( vm, &temp );
+      // the command may print.
+      FlushOutput();
       xchat_command( the_plugin, ret.c_str() );
    }
    
@@ -1654,13 +2257,13 @@ FALCON_FUNC  XChatContext_message( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_getInfo( ::Falcon::VMachine *vm )
 {
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       XChat_getInfo( vm );
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 }
 
@@ -1675,13 +2278,13 @@ FALCON_FUNC  XChatContext_getInfo( ::Falcon::VMachine *vm )
 FALCON_FUNC  XChatContext_listUsers( ::Falcon::VMachine *vm )
 {
 
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       internal_list( vm, "users" );
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 
 }
@@ -1695,16 +2298,40 @@ FALCON_FUNC  XChatContext_listUsers( ::Falcon::VMachine *vm )
 */
 FALCON_FUNC  XChatContext_listNotify( ::Falcon::VMachine *vm )
 {
-   xchat_context *oldCtx = xchat_get_context( the_plugin );
-   xchat_context *ctx = (xchat_context *) vm->self().asObject()->getUserData();
+   xchat_context *oldCtx = CurrentContext();
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
 
-   if( xchat_set_context( the_plugin, ctx ) )
+   if( SwitchContext( ctx ) )
    {
       internal_list( vm, "notify" );
-      xchat_set_context( the_plugin, oldCtx );
+      SwitchContext( oldCtx );
    }
 }
 
+/*#
+   @method run XChatContext
+   @brief Runs a function with this context made current.
+   @param func A Falcon callable item, called without parameters.
+   @return The value returned by @b func, or nil if the context has been closed.
+
+   The context is switched once before calling @b func, and restored once
+   after it returns; see @a XChat.inContext.
+*/
+FALCON_FUNC  XChatContext_run( ::Falcon::VMachine *vm )
+{
+   Item *i_callable = vm->param( 0 );
+
+   if ( i_callable == 0 || ! i_callable->isCallable() )
+   {
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).
+         extra( "C" ) );
+      return;
+   }
+
+   xchat_context *ctx = ObjectContext( vm->self().asObject() );
+   internal_run_in_context( vm, ctx, *i_callable );
+}
+
 
 //==================================================
 // XChatHook class
@@ -1735,6 +2362,7 @@ FALCON_FUNC  XChatContext_listNotify( ::Falcon::VMachine *vm )
    @see XChat.hookPrint
    @see XChat.hookServer
    @see XChat.hookTimer
+   @see XChat.hookInterval
 */
 
 /*#
@@ -1757,6 +2385,95 @@ FALCON_FUNC  XChatHook_unhook( ::Falcon::VMachine *vm )
    xvm->scriptData()->removeHook( self );
 }
 
+//==================================================
+// XChatEvent class
+
+/*#
+   @class XChatEvent
+   @brief Event data decoded on demand.
+
+   Instances of this class are passed to the callbacks of print and
+   server hooks created with the "lazy" option, in place of the event
+   data dictionary. The fields of the event can be accessed with the
+   same keys and the same accessor used for the dictionary, but they are
+   extracted from the raw XChat data only when the script reads them.
+
+   The instance stays valid also after the callback returns, so it can be
+   stored and read later.
+
+   This class cannot be directly instantiated.
+
+   @see XChat.hookPrint
+   @see XChat.hookServer
+*/
+
+static LazyEvent *internal_self_event( VMachine *vm )
+{
+   return (LazyEvent *) vm->self().asObject()->getUserData();
+}
+
+/*#
+   @method __getIndex XChatEvent
+   @brief Accessor override; reads a field of the event.
+   @param key The name of the field.
+   @return The value of the field.
+   @raise AccessError if the event has not the given field.
+*/
+FALCON_FUNC  XChatEvent_getIndex( ::Falcon::VMachine *vm )
+{
+   Item *i_key = vm->param( 0 );
+   if ( i_key == 0 || ! i_key->isString() )
+   {
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).extra( "S" ) );
+      return;
+   }
+
+   Item value;
+   if ( ! internal_self_event( vm )->get( *i_key->asString(), value ) )
+   {
+      throw new AccessError( ErrorParam( e_arracc, __LINE__ ) );
+      return;
+   }
+
+   vm->retval( value );
+}
+
+/*#
+   @method get XChatEvent
+   @brief Reads a field of the event, or returns a default.
+   @param key The name of the field.
+   @optparam default The value returned if the field is not available.
+   @return The value of the field, or the @b default value (nil if not given).
+*/
+FALCON_FUNC  XChatEvent_get( ::Falcon::VMachine *vm )
+{
+   Item *i_key = vm->param( 0 );
+   Item *i_default = vm->param( 1 );
+   if ( i_key == 0 || ! i_key->isString() )
+   {
+      throw  new ParamError( ErrorParam( e_inv_params, __LINE__ ).extra( "S,[X]" ) );
+      return;
+   }
+
+   Item value;
+   if ( internal_self_event( vm )->get( *i_key->asString(), value ) )
+      vm->retval( value );
+   else if ( i_default != 0 )
+      vm->retval( *i_default );
+   else
+      vm->retnil();
+}
+
+/*#
+   @method toDict XChatEvent
+   @brief Decodes all the fields of the event.
+   @return A dictionary identical to the one received by non-lazy hooks.
+*/
+FALCON_FUNC  XChatEvent_toDict( ::Falcon::VMachine *vm )
+{
+   vm->retval( internal_self_event( vm )->toDict() );
+}
+
 } // namespace EXT
 
 //================================================
@@ -1787,10 +2504,12 @@ Module *create_xchat_module()
    self->addClassMethod( c_xchat, "sendModes", &Falcon::Ext::XChat_sendModes );
    self->addClassMethod( c_xchat, "findContext", &Falcon::Ext::XChat_findContext );
    self->addClassMethod( c_xchat, "getContext", &Falcon::Ext::XChat_getContext );
+   self->addClassMethod( c_xchat, "inContext", &Falcon::Ext::XChat_inContext );
    self->addClassMethod( c_xchat, "getInfo", &Falcon::Ext::XChat_getInfo );
    self->addClassMethod( c_xchat, "getPrefs", &Falcon::Ext::XChat_getPrefs );
    self->addClassMethod( c_xchat, "nickcmp", &Falcon::Ext::XChat_nickcmp );
    self->addClassMethod( c_xchat, "strip", &Falcon::Ext::XChat_strip );
+   self->addClassMethod( c_xchat, "parsePrefix", &Falcon::Ext::XChat_parsePrefix );
 
    self->addClassMethod( c_xchat, "listChannels", &Falcon::Ext::XChat_listChannels );
    self->addClassMethod( c_xchat, "listDcc", &Falcon::Ext::XChat_listDcc );
@@ -1803,6 +2522,7 @@ Module *create_xchat_module()
    self->addClassMethod( c_xchat, "hookPrint", &Falcon::Ext::XChat_hookPrint );
    self->addClassMethod( c_xchat, "hookServer", &Falcon::Ext::XChat_hookServer );
    self->addClassMethod( c_xchat, "hookTimer", &Falcon::Ext::XChat_hookTimer );
+   self->addClassMethod( c_xchat, "hookInterval", &Falcon::Ext::XChat_hookInterval );
 
    // create a singletone instance of %XChat class.
    Symbol *o_xchat = new Symbol( self, "XChat" );
@@ -1823,6 +2543,7 @@ Module *create_xchat_module()
    self->addClassMethod( c_ctx, "getInfo", &Falcon::Ext::XChatContext_getInfo );
    self->addClassMethod( c_ctx, "listUsers", &Falcon::Ext::XChatContext_listUsers );
    self->addClassMethod( c_ctx, "listNotify", &Falcon::Ext::XChatContext_listNotify );
+   self->addClassMethod( c_ctx, "run", &Falcon::Ext::XChatContext_run );
 
 
    // create the private class hook
@@ -1832,12 +2553,24 @@ Module *create_xchat_module()
    self->addClassProperty( c_hook, "callback" );
    self->addClassMethod( c_hook, "unhook", &Falcon::Ext::XChatHook_unhook );
 
+   // create the private class for lazy events
+   Falcon::Symbol *c_evt = self->addClass( "XChatEvent" );
+   self->addClassMethod( c_evt, "__getIndex", &Falcon::Ext::XChatEvent_getIndex );
+   self->addClassMethod( c_evt, "get", &Falcon::Ext::XChatEvent_get );
+   self->addClassMethod( c_evt, "toDict", &Falcon::Ext::XChatEvent_toDict );
+
 
    self->addConstant( "XCHAT_EAT_ALL", (Falcon::int64) XCHAT_EAT_ALL );
    self->addConstant( "XCHAT_EAT_XCHAT", (Falcon::int64) XCHAT_EAT_XCHAT );
    self->addConstant( "XCHAT_EAT_PLUGIN", (Falcon::int64) XCHAT_EAT_PLUGIN );
    self->addConstant( "XCHAT_EAT_NONE", (Falcon::int64) XCHAT_EAT_NONE );
 
+   self->addConstant( "XCHAT_PRI_HIGHEST", (Falcon::int64) XCHAT_PRI_HIGHEST );
+   self->addConstant( "XCHAT_PRI_HIGH", (Falcon::int64) XCHAT_PRI_HIGH );
+   self->addConstant( "XCHAT_PRI_NORM", (Falcon::int64) XCHAT_PRI_NORM );
+   self->addConstant( "XCHAT_PRI_LOW", (Falcon::int64) XCHAT_PRI_LOW );
+   self->addConstant( "XCHAT_PRI_LOWEST", (Falcon::int64) XCHAT_PRI_LOWEST );
+
    return self;
 }
 
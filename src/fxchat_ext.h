@@ -35,10 +35,12 @@ FALCON_FUNC  XChat_emit( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_sendModes( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_findContext( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_getContext( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChat_inContext( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_getInfo( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_getPrefs( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_nickcmp( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_strip( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChat_parsePrefix( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_listChannels( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_listDcc( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_listUsers( ::Falcon::VMachine *vm );
@@ -49,11 +51,17 @@ FALCON_FUNC  XChat_hookCommand( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_hookPrint( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_hookServer( ::Falcon::VMachine *vm );
 FALCON_FUNC  XChat_hookTimer( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChat_hookInterval( ::Falcon::VMachine *vm );
 
 FALCON_FUNC  XChatContext_set( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChatContext_run( ::Falcon::VMachine *vm );
 
 FALCON_FUNC  XChatHook_unhook( ::Falcon::VMachine *vm );
 
+FALCON_FUNC  XChatEvent_getIndex( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChatEvent_get( ::Falcon::VMachine *vm );
+FALCON_FUNC  XChatEvent_toDict( ::Falcon::VMachine *vm );
+
 }
 }
 
@@ -0,0 +1,303 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_filter.cpp
+
+   Falcon script Xchat plugin
+   Native pre-filters for print and server hooks
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:23:19
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Native pre-filters for print and server hooks.
+*/
+
+#include <string.h>
+#include <ctype.h>
+
+#include "fxchat_filter.h"
+#include "fxchat_dispatch.h"
+
+// RFC1459 case mapping: {}|^ are the lower case of []\~
+static inline int irc_tolower( unsigned char c )
+{
+   switch( c )
+   {
+      case '[': return '{';
+      case ']': return '}';
+      case '\\': return '|';
+      case '~': return '^';
+   }
+
+   return tolower( c );
+}
+
+int irc_casecmp( const char *s1, const char *s2 )
+{
+   const unsigned char *p1 = (const unsigned char *) s1;
+   const unsigned char *p2 = (const unsigned char *) s2;
+
+   while( *p1 != 0 && irc_tolower( *p1 ) == irc_tolower( *p2 ) )
+   {
+      ++p1;
+      ++p2;
+   }
+
+   return irc_tolower( *p1 ) - irc_tolower( *p2 );
+}
+
+bool irc_match_mask( const char *mask, const char *text )
+{
+   // iterative glob matching with backtracking on the last "*"
+   const char *star = 0;
+   const char *resume = 0;
+
+   while( *text != 0 )
+   {
+      if ( *mask == '*' )
+      {
+         star = mask++;
+         resume = text;
+      }
+      else if ( *mask == '?' ||
+            ( *mask != 0 && irc_tolower( *mask ) == irc_tolower( *text ) ) )
+      {
+         ++mask;
+         ++text;
+      }
+      else if ( star != 0 )
+      {
+         mask = star + 1;
+         text = ++resume;
+      }
+      else
+         return false;
+   }
+
+   while( *mask == '*' )
+      ++mask;
+
+   return *mask == 0;
+}
+
+static bool ascii_contains_nocase( const char *text, const std::string &needle )
+{
+   size_t len = needle.size();
+   if ( len == 0 )
+      return true;
+
+   int first = tolower( (unsigned char) needle[0] );
+   for( ; *text != 0; ++text )
+   {
+      if ( tolower( (unsigned char) *text ) == first &&
+            strncasecmp( text, needle.c_str(), len ) == 0 )
+         return true;
+   }
+
+   return false;
+}
+
+
+HookFilter::HookFilter( bool bServer, const ParamDescList *params ):
+   m_bServer( bServer ),
+   m_params( params ),
+   m_bFullMask( false ),
+   m_bRegex( false )
+{
+   m_targetField = findField( "target" );
+   if ( m_targetField < 0 )
+      m_targetField = findField( "channel" );
+
+   m_messageField = findField( "message" );
+   if ( m_messageField < 0 )
+      m_messageField = findField( "text" );
+
+   m_nickField = findField( "nick" );
+}
+
+HookFilter::~HookFilter()
+{
+   if ( m_bRegex )
+      regfree( &m_regex );
+}
+
+int HookFilter::findField( const char *name ) const
+{
+   if ( m_params == 0 )
+      return -1;
+
+   int pos = 0;
+   ParamDescList::const_iterator liter = m_params->begin();
+   while( liter != m_params->end() )
+   {
+      if ( strcmp( liter->m_param, name ) == 0 )
+         return pos;
+      ++pos;
+      ++liter;
+   }
+
+   return -1;
+}
+
+const char *HookFilter::field( int pos, char *word[], char *word_eol[] ) const
+{
+   // fields are matched against words starting from word[1]
+   int idWord = pos + 1;
+   for( int i = 1; i <= idWord; i++ )
+   {
+      if ( word[i] == 0 || word[i][0] == '\0' )
+         return 0;
+
+      // in server messages, a ":" beyond the first word means "all the rest"
+      if ( m_bServer && i > 1 && word[i][0] == ':' )
+         return i == idWord ? word_eol[i] + 1 : 0;
+   }
+
+   const char *value = word[idWord];
+   if ( m_bServer && idWord == 1 && *value == ':' )
+      ++value;
+
+   return value;
+}
+
+bool HookFilter::addTarget( const char *target )
+{
+   if ( m_targetField < 0 )
+      return false;
+
+   m_targets.push_back( target );
+   return true;
+}
+
+bool HookFilter::nickMask( const char *mask )
+{
+   // server messages have the sender in the first word
+   if ( ! m_bServer && m_nickField < 0 )
+      return false;
+
+   m_nickMask = mask;
+   // masks including user or host are checked against the whole sender
+   m_bFullMask = m_bServer && strpbrk( mask, "!@" ) != 0;
+   return true;
+}
+
+bool HookFilter::prefix( const char *prefix )
+{
+   if ( m_messageField < 0 )
+      return false;
+
+   m_prefix = prefix;
+   return true;
+}
+
+bool HookFilter::contains( const char *text )
+{
+   if ( m_messageField < 0 )
+      return false;
+
+   m_contains = text;
+   return true;
+}
+
+bool HookFilter::regex( const char *expr )
+{
+   if ( m_messageField < 0 )
+      return false;
+
+   if ( m_bRegex )
+   {
+      regfree( &m_regex );
+      m_bRegex = false;
+   }
+
+   if ( regcomp( &m_regex, expr, REG_EXTENDED | REG_NOSUB ) != 0 )
+      return false;
+
+   m_bRegex = true;
+   return true;
+}
+
+bool HookFilter::match( char *word[], char *word_eol[] ) const
+{
+   return matchValues(
+      m_targets.empty() ? 0 : field( m_targetField, word, word_eol ),
+      m_nickMask.empty() ? 0 : field( m_bServer ? 0 : m_nickField, word, word_eol ),
+      field( m_messageField, word, word_eol ) );
+}
+
+bool HookFilter::match( const ServerMessage &msg ) const
+{
+   return matchValues( msg.field( m_targetField ), msg.source(), msg.field( m_messageField ) );
+}
+
+bool HookFilter::matchValues( const char *target, const char *source, const char *message ) const
+{
+   if ( ! m_targets.empty() )
+   {
+      if ( target == 0 )
+         return false;
+
+      bool bFound = false;
+      for( size_t i = 0; i < m_targets.size(); i++ )
+      {
+         if ( irc_casecmp( target, m_targets[i].c_str() ) == 0 )
+         {
+            bFound = true;
+            break;
+         }
+      }
+
+      if ( ! bFound )
+         return false;
+   }
+
+   if ( ! m_nickMask.empty() )
+   {
+      if ( source == 0 )
+         return false;
+
+      if ( m_bFullMask )
+      {
+         if ( ! irc_match_mask( m_nickMask.c_str(), source ) )
+            return false;
+      }
+      else {
+         // match the nick part only
+         char nick[128];
+         size_t len = strcspn( source, "!" );
+         if ( len >= sizeof( nick ) )
+            return false;
+         memcpy( nick, source, len );
+         nick[len] = '\0';
+
+         if ( ! irc_match_mask( m_nickMask.c_str(), nick ) )
+            return false;
+      }
+   }
+
+   if ( ! m_prefix.empty() || ! m_contains.empty() || m_bRegex )
+   {
+      if ( message == 0 )
+         return false;
+
+      if ( ! m_prefix.empty() && strncmp( message, m_prefix.c_str(), m_prefix.size() ) != 0 )
+         return false;
+
+      if ( ! m_contains.empty() && ! ascii_contains_nocase( message, m_contains ) )
+         return false;
+
+      if ( m_bRegex && regexec( &m_regex, message, 0, 0, 0 ) != 0 )
+         return false;
+   }
+
+   return true;
+}
+
+/* end of fxchat_filter.cpp */
@@ -0,0 +1,84 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_filter.h
+
+   Falcon script Xchat plugin
+   Native pre-filters for print and server hooks
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:23:19
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Native pre-filters for print and server hooks.
+*/
+
+#ifndef fxchat_filter_H
+#define fxchat_filter_H
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <regex.h>
+
+#include "fxchat_events.h"
+
+class ServerMessage;
+
+// A filter checked against the raw xchat words before the
+// script is called. All the criteria that have been set must match.
+// Strings are stored and compared in their utf-8 form.
+class HookFilter
+{
+   bool m_bServer;
+   const ParamDescList *m_params;
+
+   // positions of the fields in the parameter plan (-1 if not available)
+   int m_targetField;
+   int m_messageField;
+   int m_nickField;
+
+   std::vector<std::string> m_targets;
+   std::string m_nickMask;
+   bool m_bFullMask;
+   std::string m_prefix;
+   std::string m_contains;
+
+   regex_t m_regex;
+   bool m_bRegex;
+
+   int findField( const char *name ) const;
+   const char *field( int pos, char *word[], char *word_eol[] ) const;
+   bool matchValues( const char *target, const char *source, const char *message ) const;
+
+public:
+   HookFilter( bool bServer, const ParamDescList *params );
+   ~HookFilter();
+
+   // Setters return false if the event has not the needed field.
+   bool addTarget( const char *target );
+   bool nickMask( const char *mask );
+   bool prefix( const char *prefix );
+   bool contains( const char *text );
+   // returns false also if the expression can't be compiled.
+   bool regex( const char *expr );
+
+   bool match( char *word[], char *word_eol[] ) const;
+   // server messages already parsed by the dispatcher
+   bool match( const ServerMessage &msg ) const;
+};
+
+// Utilities used also elsewhere.
+int irc_casecmp( const char *s1, const char *s2 );
+bool irc_match_mask( const char *mask, const char *text );
+
+#endif
+
+/* end of fxchat_filter.h */
@@ -0,0 +1,182 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_gc.cpp
+
+   Falcon script Xchat plugin
+   Idle time garbage collection
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:52:39
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Idle time garbage collection.
+*/
+
+#include <falcon/engine.h>
+#include <falcon/mempool.h>
+
+#include <sys/time.h>
+
+#include "fxchat.h"
+#include "fxchat_gc.h"
+#include "fxchat_mem.h"
+#include "fxchat_script.h"
+#include "fxchat_vm.h"
+
+#define GC_TICK_MSECS      250
+#define GC_IDLE_MSECS      500
+#define GC_MIN_GROWTH      (256*1024)
+#define GC_MAX_GROWTH      (32*1024*1024)
+
+static xchat_hook *s_gcTimer = 0;
+static int s_budget = 20;
+
+static long s_lastActivity = 0;  // msecs
+static long s_baseBytes = 0;     // heap after the last collection
+
+// statistics
+static long s_cycles = 0;
+static long s_skipped = 0;
+static long s_totalPause = 0;    // usecs
+static long s_maxPause = 0;
+static long s_lastPause = 0;
+static double s_usecsPerKB = 0.0;
+
+static long internal_usecs()
+{
+   struct timeval tv;
+   gettimeofday( &tv, 0 );
+   return tv.tv_sec * 1000000L + tv.tv_usec;
+}
+
+// the engine collects on its own only past the hard bound.
+static void internal_threshold()
+{
+   Falcon::memPool->thresholdNormal( s_baseBytes + GC_MAX_GROWTH );
+   Falcon::memPool->thresholdActive( s_baseBytes + GC_MAX_GROWTH * 2 );
+}
+
+static void internal_collect()
+{
+   for( MemAccount *acc = FirstMemAccount(); acc != 0; acc = acc->nextAccount() )
+      acc->markCollection();
+
+   long heapKB = TotalGCBytes() / 1024;
+   long start = internal_usecs();
+   Falcon::memPool->performGC();
+   long pause = internal_usecs() - start;
+
+   ++s_cycles;
+   s_totalPause += pause;
+   s_lastPause = pause;
+   if ( pause > s_maxPause )
+      s_maxPause = pause;
+   if ( heapKB > 0 )
+      s_usecsPerKB = (double) pause / heapKB;
+
+   // each VM takes the part of the pause of the blocks it lost.
+   long collected = 0;
+   for( MemAccount *acc = FirstMemAccount(); acc != 0; acc = acc->nextAccount() )
+      collected += acc->collectedSinceMark();
+
+   for( MemAccount *acc = FirstMemAccount(); acc != 0; acc = acc->nextAccount() )
+   {
+      long own = acc->collectedSinceMark();
+      if ( own > 0 )
+         acc->chargeCollection( (long)( (double) pause * own / collected ) );
+   }
+
+   s_baseBytes = TotalGCBytes();
+   internal_threshold();
+}
+
+extern "C" int gc_timer_cb( void *user_data )
+{
+   long growth = TotalGCBytes() - s_baseBytes;
+   if ( growth < GC_MIN_GROWTH )
+      return 1;
+
+   // past half the hard bound, we don't wait anymore.
+   bool bUrgent = growth > GC_MAX_GROWTH / 2;
+
+   if ( ! bUrgent )
+   {
+      if ( internal_usecs() / 1000 - s_lastActivity < GC_IDLE_MSECS )
+         return 1;
+
+      double predicted = s_usecsPerKB * ( TotalGCBytes() / 1024 );
+      if ( predicted > s_budget * 1000.0 )
+      {
+         ++s_skipped;
+         return 1;
+      }
+   }
+
+   internal_collect();
+   return 1;
+}
+
+void InitGCScheduler()
+{
+   s_baseBytes = TotalGCBytes();
+   internal_threshold();
+   s_gcTimer = xchat_hook_timer( the_plugin, GC_TICK_MSECS, gc_timer_cb, 0 );
+}
+
+void ShutdownGCScheduler()
+{
+   if ( s_gcTimer != 0 )
+   {
+      xchat_unhook( the_plugin, s_gcTimer );
+      s_gcTimer = 0;
+   }
+}
+
+void NoteScriptActivity()
+{
+   s_lastActivity = internal_usecs() / 1000;
+}
+
+int GCBudget()
+{
+   return s_budget;
+}
+
+void GCBudget( int msecs )
+{
+   s_budget = msecs;
+}
+
+void PrintGCStats()
+{
+   xchat_printf( the_plugin, PNAME ": Idle collections: %ld (skipped over budget: %ld)\n",
+      s_cycles, s_skipped );
+   xchat_printf( the_plugin, PNAME ": Pause: last %ld ms, max %ld ms, average %ld ms; budget %d ms\n",
+      s_lastPause / 1000, s_maxPause / 1000, s_cycles > 0 ? s_totalPause / s_cycles / 1000 : 0,
+      s_budget );
+   xchat_printf( the_plugin, PNAME ": Heap: %ld KB, %ld KB since the last collection\n",
+      TotalGCBytes() / 1024, ( TotalGCBytes() - s_baseBytes ) / 1024 );
+
+   for( MemAccount *acc = FirstMemAccount(); acc != 0; acc = acc->nextAccount() )
+   {
+      XChatVM *vm = static_cast<XChatVM *>( acc->vm() );
+      if ( vm->isShared() )
+         xchat_print( the_plugin, PNAME ":   (shared VM)" );
+      else if ( vm->scriptData() != 0 )
+         xchat_print_falcon( PNAME ":   " + vm->scriptData()->name() );
+      else
+         continue;
+
+      xchat_printf( the_plugin, PNAME ":     %ld collections, pause %ld ms total, %ld ms max\n",
+         acc->gcCycles(), acc->gcPause() / 1000, acc->gcMaxPause() / 1000 );
+   }
+}
+
+/* end of fxchat_gc.cpp */
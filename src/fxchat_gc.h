@@ -0,0 +1,48 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_gc.h
+
+   Falcon script Xchat plugin
+   Idle time garbage collection
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:52:39
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Idle time garbage collection.
+*/
+
+#ifndef fxchat_gc_H
+#define fxchat_gc_H
+
+#include <falcon/engine.h>
+
+// The engine collector is kept out of the way by high thresholds, and
+// collections are run by the plugin from a timer, when no callback has
+// run for a while. A collection is skipped if its predicted pause is
+// over the budget, unless the heap has grown too much; the threshold
+// of the engine is the hard bound for the growth between collections.
+
+void InitGCScheduler();
+void ShutdownGCScheduler();
+
+// Records that a script is running; collection waits for quiet times.
+void NoteScriptActivity();
+
+// Pause budget of a collection, in milliseconds.
+int GCBudget();
+void GCBudget( int msecs );
+
+// Prints the statistics of the collections.
+void PrintGCStats();
+
+#endif
+
+/* end of fxchat_gc.h */
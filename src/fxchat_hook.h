@@ -24,6 +24,10 @@
 
 #include <falcon/falcondata.h>
 #include "xchat-plugin.h"
+#include "fxchat_events.h"
+#include "fxchat_filter.h"
+#include "fxchat_batch.h"
+#include "fxchat_timer.h"
 
 class ScriptData;
 
@@ -35,18 +39,52 @@ class XChatHook: public Falcon::FalconData
    ScriptData *m_owner;
    Falcon::CoreObject *m_handler;
 
+   // Parameter plan resolved at hook time; 0 for unmanaged events.
+   const ParamDescList *m_params;
+
+   // deliver the event as a lazily decoded XChatEvent instance
+   bool m_bLazy;
+
+   // native pre-filter; owned by the hook (may be 0)
+   HookFilter *m_filter;
+
+   int m_priority;
+
+   // server hooks are subscribed to the shared dispatcher
+   bool m_bDispatched;
+
+   // queue of events for batched delivery; owned by the hook (may be 0)
+   EventBatch *m_batch;
+
+   // range of numeric replies hooked, or -1 for named messages
+   int m_numFirst;
+   int m_numLast;
+
+   // timer hooks live in the timer wheel; owned by the hook (may be 0)
+   TimerEntry *m_timer;
+
 public:
    XChatHook( ScriptData *owner,
-               const Falcon::String &sMatch ):
+               const Falcon::String &sMatch,
+               const ParamDescList *params = 0 ):
       m_hook( 0 ),
       m_sMatch( sMatch ),
       m_owner( owner ),
-      m_handler( 0 )
+      m_handler( 0 ),
+      m_params( params ),
+      m_bLazy( false ),
+      m_filter( 0 ),
+      m_priority( XCHAT_PRI_NORM ),
+      m_bDispatched( false ),
+      m_batch( 0 ),
+      m_numFirst( -1 ),
+      m_numLast( -1 ),
+      m_timer( 0 )
    {
       m_sMatch.bufferize();
    }
 
-   virtual ~XChatHook() {}
+   virtual ~XChatHook() { delete m_filter; delete m_batch; delete m_timer; }
 
    ScriptData *owner() const { return m_owner; }
    const Falcon::String &match() const { return m_sMatch; }
@@ -57,6 +95,31 @@ public:
    Falcon::CoreObject *handler() const { return m_handler; }
    void handler( Falcon::CoreObject *h ) { m_handler = h; }
 
+   const ParamDescList *params() const { return m_params; }
+
+   bool lazy() const { return m_bLazy; }
+   void lazy( bool l ) { m_bLazy = l; }
+
+   HookFilter *filter() const { return m_filter; }
+   void filter( HookFilter *f ) { delete m_filter; m_filter = f; }
+
+   int priority() const { return m_priority; }
+   void priority( int p ) { m_priority = p; }
+
+   bool dispatched() const { return m_bDispatched; }
+   void dispatched( bool d ) { m_bDispatched = d; }
+
+   EventBatch *batch() const { return m_batch; }
+   void batch( EventBatch *b ) { delete m_batch; m_batch = b; }
+
+   bool numeric() const { return m_numFirst >= 0; }
+   int numFirst() const { return m_numFirst; }
+   int numLast() const { return m_numLast; }
+   void numeric( int first, int last ) { m_numFirst = first; m_numLast = last; }
+
+   TimerEntry *timer() const { return m_timer; }
+   void timer( TimerEntry *t ) { delete m_timer; m_timer = t; }
+
    virtual Falcon::FalconData* clone() const { return 0; }
    virtual void gcMark( Falcon::uint32 ) {}
 
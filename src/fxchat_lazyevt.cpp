@@ -0,0 +1,361 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_lazyevt.cpp
+
+   Falcon script Xchat plugin
+   Event data decoded on demand
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:22:09
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Event data decoded on demand.
+*/
+
+#include <falcon/engine.h>
+#include <falcon/lineardict.h>
+#include <falcon/mempool.h>
+
+#include <string.h>
+
+#include "fxchat_lazyevt.h"
+#include "fxchat.h"
+#include "fxchat_vm.h"
+#include "fxchat_prefix.h"
+
+LazyEvent::LazyEvent( XChatVM *vm, const Falcon::String &event, const ParamDescList *params,
+      bool bServer, char *word[], char *word_eol[] ):
+   m_vm( vm ),
+   m_params( params ),
+   m_bServer( bServer ),
+   m_szEvent( m_eventBuf ),
+   m_bDetached( false ),
+   m_wordCount( 1 ),
+   m_arena( 0 ),
+   m_decoded( 0 )
+{
+   if ( ! event.toCString( m_eventBuf, sizeof( m_eventBuf ) ) )
+   {
+      Falcon::uint32 size = event.length() * 4 + 1; // max utf8 size
+      m_szEvent = (char *) Falcon::memAlloc( size );
+      event.toCString( m_szEvent, size );
+   }
+
+   m_word[0] = 0;
+   m_word_eol[0] = 0;
+
+   // the list of words is terminated by an empty word.
+   while( m_wordCount < MAX_WORDS && word[m_wordCount] != 0 && word[m_wordCount][0] != '\0' )
+   {
+      m_word[m_wordCount] = word[m_wordCount];
+      m_word_eol[m_wordCount] = word_eol != 0 ? word_eol[m_wordCount] : 0;
+      ++m_wordCount;
+   }
+}
+
+
+LazyEvent::~LazyEvent()
+{
+   if ( m_arena != 0 )
+      Falcon::memFree( m_arena );
+   if ( m_szEvent != m_eventBuf )
+      Falcon::memFree( m_szEvent );
+}
+
+
+void LazyEvent::gcMark( Falcon::uint32 mark )
+{
+   for( int i = 0; i < MAX_SLOTS; i++ )
+   {
+      if ( (m_decoded & (1 << i)) != 0 )
+         Falcon::memPool->markItem( m_values[i] );
+   }
+}
+
+
+void LazyEvent::detach()
+{
+   if ( detached() )
+      return;
+
+   // In server messages, only the first word starting with ":" is
+   // used up to the end of line.
+   int eolWord = 0;
+   if ( m_bServer )
+   {
+      for( int i = 2; i < m_wordCount; i++ )
+      {
+         if ( m_word[i][0] == ':' && m_word_eol[i] != 0 )
+         {
+            eolWord = i;
+            break;
+         }
+      }
+   }
+
+   // calculate the space needed to store everything.
+   Falcon::uint32 size = 0;
+   for( int i = 1; i < m_wordCount; i++ )
+      size += strlen( m_word[i] ) + 1;
+
+   const char *eol = eolWord != 0 ? m_word_eol[eolWord] : 0;
+   if ( eol != 0 )
+      size += strlen( eol ) + 1;
+
+   m_arena = (char *) Falcon::memAlloc( size );
+   char *pos = m_arena;
+
+   for( int i = 1; i < m_wordCount; i++ )
+   {
+      Falcon::uint32 len = strlen( m_word[i] ) + 1;
+      memcpy( pos, m_word[i], len );
+      m_word[i] = pos;
+      m_word_eol[i] = 0;
+      pos += len;
+   }
+
+   if ( eol != 0 )
+   {
+      // word_eol was cleared above; only the one we need is restored.
+      memcpy( pos, eol, strlen( eol ) + 1 );
+      m_word_eol[eolWord] = pos;
+   }
+
+   m_bDetached = true;
+}
+
+
+int LazyEvent::findSlot( const Falcon::String &key ) const
+{
+   // unmanaged events have just a name and the list of words
+   if ( m_params == 0 )
+   {
+      if ( key == "event" )
+         return 0;
+      if ( key == "wordlist" )
+         return 1;
+      return -1;
+   }
+
+   int slot = 0;
+   if ( m_bServer )
+   {
+      if ( key == "nick" )
+         return SLOT_NICK;
+      if ( key == "nick:user" )
+         return SLOT_NICK_USER;
+      if ( key == "nick:net" )
+         return SLOT_NICK_NET;
+      slot = SLOT_SRV_FIRST_PARAM;
+   }
+
+   ParamDescList::const_iterator liter = m_params->begin();
+   while( liter != m_params->end() )
+   {
+      if ( liter->m_key >= 0 && key == liter->m_param )
+         return slot;
+      ++slot;
+      ++liter;
+   }
+
+   // print events have the event name after the parameters
+   if ( ! m_bServer && key == "event" )
+      return slot;
+
+   return -1;
+}
+
+
+Falcon::String *LazyEvent::eventName() const
+{
+   return FastUTF8String( m_szEvent );
+}
+
+
+bool LazyEvent::decodeNick( int slot, Falcon::Item &value )
+{
+   if ( m_wordCount < 2 )
+      return false;
+
+   IrcPrefix prefix( m_word[1] );
+   if ( ! prefix.isUser() )
+      return false;
+
+   switch( slot )
+   {
+      case SLOT_NICK:
+         value = prefix.nickString();
+         return true;
+
+      case SLOT_NICK_USER:
+         if ( ! prefix.hasUser() )
+            return false;
+         value = prefix.userString();
+         return true;
+   }
+
+   if ( ! prefix.hasHost() )
+      return false;
+   value = prefix.hostString();
+   return true;
+}
+
+
+bool LazyEvent::decodeServerParam( int param, Falcon::Item &value )
+{
+   // parameters are matched against words starting from word[1]
+   int idWord = param + 1;
+   if ( idWord >= m_wordCount )
+      return false;
+
+   // a ":" beyond the first element means "all the rest";
+   // no parameter is filled after that.
+   for( int i = 2; i < idWord; i++ )
+   {
+      if ( m_word[i][0] == ':' )
+         return false;
+   }
+
+   const char *curWord = m_word[idWord];
+   if ( idWord == 1 )
+   {
+      value = FastUTF8String( curWord[0] == ':' ? curWord + 1 : curWord );
+   }
+   else if ( curWord[0] == ':' )
+   {
+      value = FastUTF8String( m_word_eol[idWord] + 1 );
+   }
+   else {
+      value = FastUTF8String( curWord );
+   }
+
+   return true;
+}
+
+
+bool LazyEvent::decodeSlot( int slot, Falcon::Item &value )
+{
+   if ( m_params == 0 )
+   {
+      if ( slot == 0 )
+      {
+         value = eventName();
+      }
+      else {
+         Falcon::CoreArray *theArray = new Falcon::CoreArray;
+         for( int i = 1; i < m_wordCount; i++ )
+            theArray->append( FastUTF8String( m_word[i] ) );
+         value = theArray;
+      }
+      return true;
+   }
+
+   if ( m_bServer )
+   {
+      if ( slot < SLOT_SRV_FIRST_PARAM )
+         return decodeNick( slot, value );
+
+      return decodeServerParam( slot - SLOT_SRV_FIRST_PARAM, value );
+   }
+
+   // print events; the slot after the parameters is the event name.
+   if ( slot == (int) m_params->size() )
+   {
+      value = eventName();
+      return true;
+   }
+
+   if ( slot + 1 >= m_wordCount )
+      return false;
+
+   value = FastUTF8String( m_word[ slot + 1 ] );
+   return true;
+}
+
+
+bool LazyEvent::fetch( int slot, Falcon::Item &value )
+{
+   if ( slot >= MAX_SLOTS )
+      return decodeSlot( slot, value );
+
+   if ( (m_decoded & (1 << slot)) != 0 )
+   {
+      value = m_values[slot];
+      return true;
+   }
+
+   if ( ! decodeSlot( slot, m_values[slot] ) )
+      return false;
+
+   m_decoded |= 1 << slot;
+   value = m_values[slot];
+   return true;
+}
+
+
+bool LazyEvent::get( const Falcon::String &key, Falcon::Item &value )
+{
+   int slot = findSlot( key );
+   if ( slot < 0 )
+      return false;
+
+   return fetch( slot, value );
+}
+
+
+Falcon::CoreDict *LazyEvent::toDict()
+{
+   Falcon::LinearDict *eventInfo = new Falcon::LinearDict( 10 );
+   Falcon::Item value;
+
+   if ( m_params == 0 )
+   {
+      if ( fetch( 0, value ) )
+         eventInfo->put( m_vm->key( KEY_EVENT ), value );
+      if ( fetch( 1, value ) )
+         eventInfo->put( m_vm->key( KEY_WORDLIST ), value );
+
+      return new Falcon::CoreDict( eventInfo );
+   }
+
+   int slot = 0;
+   if ( m_bServer )
+   {
+      if ( fetch( SLOT_NICK, value ) )
+      {
+         eventInfo->put( m_vm->key( KEY_NICK ), value );
+         if ( fetch( SLOT_NICK_USER, value ) )
+            eventInfo->put( m_vm->key( KEY_NICK_USER ), value );
+         if ( fetch( SLOT_NICK_NET, value ) )
+            eventInfo->put( m_vm->key( KEY_NICK_NET ), value );
+      }
+      slot = SLOT_SRV_FIRST_PARAM;
+   }
+
+   ParamDescList::const_iterator liter = m_params->begin();
+   while( liter != m_params->end() )
+   {
+      // parameters are positional; the first missing one ends the list.
+      if ( ! fetch( slot, value ) )
+         break;
+
+      if ( liter->m_key >= 0 )
+         eventInfo->put( m_vm->key( liter->m_key ), value );
+      ++slot;
+      ++liter;
+   }
+
+   if ( ! m_bServer && fetch( (int) m_params->size(), value ) )
+      eventInfo->put( m_vm->key( KEY_EVENT ), value );
+
+   return new Falcon::CoreDict( eventInfo );
+}
+
+/* end of fxchat_lazyevt.cpp */
@@ -0,0 +1,97 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_lazyevt.h
+
+   Falcon script Xchat plugin
+   Event data decoded on demand
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:22:09
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Event data decoded on demand.
+*/
+
+#ifndef fxchat_lazyevt_H
+#define fxchat_lazyevt_H
+
+#include <falcon/engine.h>
+#include <falcon/falcondata.h>
+#include "fxchat_events.h"
+
+class XChatVM;
+
+// Carrier for XChatEvent instances.
+// While the callback is running, the event refers directly to the
+// word arrays provided by xchat; each field is decoded and cached the first
+// time the script asks for it. When the callback returns, detach() copies
+// the raw words in a private buffer, so that the script can still use
+// the event if it has stored it somewhere.
+class LazyEvent: public Falcon::FalconData
+{
+   enum {
+      MAX_WORDS = 32,
+      MAX_SLOTS = 16,
+      // slots used by server messages to store the nick parts
+      SLOT_NICK = 0,
+      SLOT_NICK_USER = 1,
+      SLOT_NICK_NET = 2,
+      SLOT_SRV_FIRST_PARAM = 3
+   };
+
+   XChatVM *m_vm;
+   const ParamDescList *m_params;
+   bool m_bServer;
+
+   // utf-8 event name, copied at creation as the hook naming it may be
+   // destroyed by the callback; it's in m_eventBuf unless it's too long.
+   char m_eventBuf[ 64 ];
+   char *m_szEvent;
+   bool m_bDetached;
+
+   char *m_word[ MAX_WORDS ];
+   char *m_word_eol[ MAX_WORDS ];
+   int m_wordCount;
+
+   // private copy of the words after detach()
+   char *m_arena;
+
+   Falcon::Item m_values[ MAX_SLOTS ];
+   Falcon::uint32 m_decoded;
+
+   int findSlot( const Falcon::String &key ) const;
+   bool fetch( int slot, Falcon::Item &value );
+   bool decodeSlot( int slot, Falcon::Item &value );
+   bool decodeNick( int slot, Falcon::Item &value );
+   bool decodeServerParam( int param, Falcon::Item &value );
+   Falcon::String *eventName() const;
+
+public:
+   LazyEvent( XChatVM *vm, const Falcon::String &event, const ParamDescList *params,
+         bool bServer, char *word[], char *word_eol[] );
+   virtual ~LazyEvent();
+
+   // Reads a field of the event; returns false if the event has not that field.
+   bool get( const Falcon::String &key, Falcon::Item &value );
+
+   // Creates the same dictionary that a non-lazy hook would receive.
+   Falcon::CoreDict *toDict();
+
+   // To be called as soon as the callback returns.
+   void detach();
+   bool detached() const { return m_bDetached; }
+
+   virtual Falcon::FalconData* clone() const { return 0; }
+   virtual void gcMark( Falcon::uint32 mark );
+};
+
+#endif
+
+/* end of fxchat_lazyevt.h */
@@ -0,0 +1,421 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_loader.cpp
+
+   Falcon script Xchat plugin
+   Background compilation of scripts
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:44:44
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Background compilation of scripts.
+*/
+
+#include <falcon/engine.h>
+
+#include <pthread.h>
+#include <sys/time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include "fxchat.h"
+#include "fxchat_loader.h"
+#include "fxchat_cache.h"
+#include "fxchat_errhand.h"
+#include "fxchat_vm.h"
+
+#define MAX_LOAD_WORKERS 4
+
+// A script on its way from the disk to the main thread.
+class LoadJob
+{
+public:
+   Falcon::String m_fname;
+   Falcon::String m_target;   // script to be hot reloaded, if any
+   char **m_args;
+   bool m_bShared;
+   long m_heapLimit;
+   Falcon::ModuleLoader *m_loader;
+   Falcon::Runtime *m_runtime;
+   Falcon::Module *m_module;
+   Falcon::Error *m_error;
+   struct timeval m_start;
+   LoadJob *m_next;
+
+   LoadJob( const Falcon::String &fname, char **args );
+   ~LoadJob();
+};
+
+LoadJob::LoadJob( const Falcon::String &fname, char **args ):
+   m_fname( fname ),
+   m_bShared( false ),
+   m_heapLimit( 0 ),
+   m_loader( 0 ),
+   m_runtime( 0 ),
+   m_module( 0 ),
+   m_error( 0 ),
+   m_next( 0 )
+{
+   // the strings may belong to xchat; they must survive the command.
+   int count = 0;
+   while( args != 0 && args[count] != 0 && args[count][0] != '\0' )
+      ++count;
+
+   m_args = new char*[ count + 1 ];
+   for( int i = 0; i < count; i++ )
+   {
+      m_args[i] = new char[ strlen( args[i] ) + 1 ];
+      strcpy( m_args[i], args[i] );
+   }
+   m_args[count] = 0;
+
+   m_fname.bufferize();
+   gettimeofday( &m_start, 0 );
+}
+
+LoadJob::~LoadJob()
+{
+   for( int i = 0; m_args[i] != 0; i++ )
+      delete[] m_args[i];
+   delete[] m_args;
+
+   // the runtime keeps its own references to the modules.
+   delete m_runtime;
+   if ( m_module != 0 )
+      m_module->decref();
+   delete m_loader;
+   if ( m_error != 0 )
+      m_error->decref();
+}
+
+//==============================================
+// Shared state; everything is protected by s_mtx.
+//
+
+static pthread_mutex_t s_mtx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_idle = PTHREAD_COND_INITIALIZER;
+
+static Falcon::String s_loadPath;
+static LoadJob *s_queue = 0;      // waiting for a worker
+static LoadJob *s_queueTail = 0;
+static LoadJob *s_running = 0;    // being compiled (for listing)
+static LoadJob *s_done = 0;       // waiting for the main thread
+static int s_workers = 0;
+static bool s_quitting = false;
+
+static int s_pipe[2] = { -1, -1 };
+static xchat_hook *s_pipeHook = 0;
+
+static void internal_unlink( LoadJob *&list, LoadJob *job )
+{
+   LoadJob **pos = &list;
+   while( *pos != job )
+      pos = &(*pos)->m_next;
+   *pos = job->m_next;
+   job->m_next = 0;
+}
+
+// Compilation and resolution of the references; no xchat call here.
+static void internal_compile( LoadJob *job )
+{
+   job->m_loader = new Falcon::ModuleLoader( s_loadPath );
+
+   try
+   {
+      // a compiled copy in the cache spares us the compiler.
+      job->m_module = LoadCachedModule( job->m_loader, job->m_fname );
+      if ( job->m_module == 0 )
+      {
+         job->m_module = job->m_loader->loadSource( job->m_fname );
+         StoreCachedModule( job->m_module, job->m_fname );
+      }
+
+      // loads the modules required by the script.
+      job->m_runtime = new Falcon::Runtime( job->m_loader );
+      job->m_runtime->addModule( job->m_module );
+   }
+   catch( Falcon::Error *err )
+   {
+      job->m_error = err;
+   }
+}
+
+static void *loader_thread( void * )
+{
+   pthread_mutex_lock( &s_mtx );
+
+   while( s_queue != 0 && ! s_quitting )
+   {
+      LoadJob *job = s_queue;
+      s_queue = job->m_next;
+      if ( s_queue == 0 )
+         s_queueTail = 0;
+      job->m_next = s_running;
+      s_running = job;
+      pthread_mutex_unlock( &s_mtx );
+
+      internal_compile( job );
+
+      pthread_mutex_lock( &s_mtx );
+      internal_unlink( s_running, job );
+      job->m_next = s_done;
+      s_done = job;
+      pthread_mutex_unlock( &s_mtx );
+
+      // wake up the main thread; if the pipe is full, a byte
+      // is already waiting to be read, and that's enough.
+      char c = 0;
+      while( write( s_pipe[1], &c, 1 ) < 0 && errno == EINTR )
+         ;
+
+      pthread_mutex_lock( &s_mtx );
+   }
+
+   --s_workers;
+   pthread_cond_signal( &s_idle );
+   pthread_mutex_unlock( &s_mtx );
+   return 0;
+}
+
+// Installs the completed loads, in the main thread.
+extern "C" int loader_pipe_cb( int fd, int flags, void *user_data )
+{
+   char buf[64];
+   while( read( fd, buf, sizeof( buf ) ) == sizeof( buf ) )
+      ;
+
+   pthread_mutex_lock( &s_mtx );
+   LoadJob *done = s_done;
+   s_done = 0;
+   pthread_mutex_unlock( &s_mtx );
+
+   // the list is in reverse completion order; restore it.
+   LoadJob *job = 0;
+   while( done != 0 )
+   {
+      LoadJob *next = done->m_next;
+      done->m_next = job;
+      job = done;
+      done = next;
+   }
+
+   while( job != 0 )
+   {
+      LoadJob *next = job->m_next;
+
+      if ( job->m_error != 0 )
+      {
+         XChatErrHand::handleError( job->m_error );
+         job->m_error = 0;
+      }
+      else
+      {
+         struct timeval now;
+         gettimeofday( &now, 0 );
+         int msecs = (now.tv_sec - job->m_start.tv_sec) * 1000 +
+                     (now.tv_usec - job->m_start.tv_usec) / 1000;
+
+         Falcon::AutoCString cname( job->m_fname );
+         xchat_printf( the_plugin, PNAME ": Compiled %s in %d ms", cname.c_str(), msecs );
+
+         if ( job->m_target.size() != 0 )
+            HotReloadModule( job->m_target, job->m_module, job->m_runtime );
+         else
+            InstallModule( job->m_module, job->m_runtime, job->m_args, job->m_bShared, job->m_heapLimit );
+      }
+
+      delete job;
+      job = next;
+   }
+
+   return 1;
+}
+
+bool InitAsyncLoader( const Falcon::String &loadPath )
+{
+   s_loadPath = loadPath;
+   s_loadPath.bufferize();
+   s_quitting = false;
+
+   if ( pipe( s_pipe ) != 0 )
+      return false;
+
+   // neither side must ever block.
+   fcntl( s_pipe[0], F_SETFL, O_NONBLOCK );
+   fcntl( s_pipe[1], F_SETFL, O_NONBLOCK );
+   s_pipeHook = xchat_hook_fd( the_plugin, s_pipe[0], XCHAT_FD_READ, loader_pipe_cb, 0 );
+   return true;
+}
+
+void ShutdownAsyncLoader()
+{
+   pthread_mutex_lock( &s_mtx );
+   s_quitting = true;
+   while( s_workers > 0 )
+      pthread_cond_wait( &s_idle, &s_mtx );
+
+   LoadJob *lists[2] = { s_queue, s_done };
+   s_queue = s_queueTail = s_done = 0;
+   pthread_mutex_unlock( &s_mtx );
+
+   for( int i = 0; i < 2; i++ )
+   {
+      while( lists[i] != 0 )
+      {
+         LoadJob *next = lists[i]->m_next;
+         delete lists[i];
+         lists[i] = next;
+      }
+   }
+
+   if ( s_pipeHook != 0 )
+   {
+      xchat_unhook( the_plugin, s_pipeHook );
+      s_pipeHook = 0;
+   }
+
+   if ( s_pipe[0] >= 0 )
+   {
+      close( s_pipe[0] );
+      close( s_pipe[1] );
+      s_pipe[0] = s_pipe[1] = -1;
+   }
+}
+
+// Scripts on their way that will need a VM of their own.
+static int internal_count_vm_loads( LoadJob *list )
+{
+   int count = 0;
+   for( ; list != 0; list = list->m_next )
+   {
+      if ( ! list->m_bShared && list->m_target.size() == 0 )
+         ++count;
+   }
+   return count;
+}
+
+static void internal_enqueue( LoadJob *job )
+{
+   xchat_print_falcon( PNAME ": Compiling " + job->m_fname + "...\n" );
+
+   pthread_mutex_lock( &s_mtx );
+   if ( s_queueTail != 0 )
+      s_queueTail->m_next = job;
+   else
+      s_queue = job;
+   s_queueTail = job;
+
+   // no notification without the pipe.
+   if ( s_pipeHook != 0 && s_workers < MAX_LOAD_WORKERS )
+   {
+      pthread_t th;
+      pthread_attr_t attr;
+      pthread_attr_init( &attr );
+      pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+
+      if ( pthread_create( &th, &attr, loader_thread, 0 ) == 0 )
+         ++s_workers;
+      pthread_attr_destroy( &attr );
+   }
+
+   LoadJob *orphans = 0;
+   if ( s_workers == 0 )
+   {
+      orphans = s_queue;
+      s_queue = s_queueTail = 0;
+   }
+
+   int vmLoads = internal_count_vm_loads( s_queue ) + internal_count_vm_loads( s_running )
+         + internal_count_vm_loads( s_done ) + internal_count_vm_loads( orphans );
+   pthread_mutex_unlock( &s_mtx );
+
+   // the VMs are prepared while the scripts are being compiled.
+   XChatVM::preparePrelinked( vmLoads );
+
+   // without threads, do it the old way.
+   if ( orphans != 0 )
+   {
+      while( orphans != 0 )
+      {
+         LoadJob *next = orphans->m_next;
+         internal_compile( orphans );
+
+         pthread_mutex_lock( &s_mtx );
+         orphans->m_next = s_done;
+         s_done = orphans;
+         pthread_mutex_unlock( &s_mtx );
+         orphans = next;
+      }
+
+      loader_pipe_cb( s_pipe[0], XCHAT_FD_READ, 0 );
+   }
+}
+
+void LoadScriptAsync( const Falcon::String &fname, char **args, bool bShared, long heapLimit )
+{
+   LoadJob *job = new LoadJob( fname, args );
+   job->m_bShared = bShared;
+   job->m_heapLimit = heapLimit;
+   internal_enqueue( job );
+}
+
+void ReloadScriptAsync( const Falcon::String &fname, const Falcon::String &target )
+{
+   LoadJob *job = new LoadJob( fname, 0 );
+   job->m_target = target;
+   job->m_target.bufferize();
+   internal_enqueue( job );
+}
+
+int AutoloadScripts( const Falcon::String &dir, bool bShared )
+{
+   Falcon::AutoCString cdir( dir );
+   DIR *dh = opendir( cdir.c_str() );
+   if ( dh == 0 )
+      return 0;
+
+   int count = 0;
+   struct dirent *ent;
+   while( ( ent = readdir( dh ) ) != 0 )
+   {
+      int len = strlen( ent->d_name );
+      if ( len > 4 && strcmp( ent->d_name + len - 4, ".fal" ) == 0 )
+      {
+         Falcon::String fname;
+         fname.fromUTF8( ent->d_name );
+         LoadScriptAsync( dir + "/" + fname, 0, bShared );
+         ++count;
+      }
+   }
+
+   closedir( dh );
+   return count;
+}
+
+void ListPendingLoads()
+{
+   pthread_mutex_lock( &s_mtx );
+   LoadJob *lists[2] = { s_running, s_queue };
+   for( int i = 0; i < 2; i++ )
+   {
+      for( LoadJob *job = lists[i]; job != 0; job = job->m_next )
+      {
+         xchat_print_falcon( Falcon::String( PNAME ": " ) + job->m_fname +
+               ( i == 0 ? " (compiling)\n" : " (queued)\n" ) );
+      }
+   }
+   pthread_mutex_unlock( &s_mtx );
+}
+
+/* end of fxchat_loader.cpp */
@@ -0,0 +1,54 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_loader.h
+
+   Falcon script Xchat plugin
+   Background compilation of scripts
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:44:44
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Background compilation of scripts.
+*/
+
+#ifndef fxchat_loader_H
+#define fxchat_loader_H
+
+#include <falcon/engine.h>
+
+// Scripts are compiled and their references resolved by a small pool of
+// worker threads, each with its own module loader. Completed loads are
+// notified through a pipe watched by xchat, so that the VM is created
+// and the script is run in the main thread, as all the xchat calls must.
+
+// Sets the load path of the workers and hooks the notification pipe.
+bool InitAsyncLoader( const Falcon::String &loadPath );
+
+// Waits for the running workers and discards their results.
+void ShutdownAsyncLoader();
+
+// Queues a script for loading; the args are copied.
+// A heap limit in bytes can be given to the VM of the script.
+void LoadScriptAsync( const Falcon::String &fname, char **args, bool bShared = false, long heapLimit = 0 );
+
+// Queues a new version of a running script, to be hot reloaded in it.
+void ReloadScriptAsync( const Falcon::String &fname, const Falcon::String &target );
+
+// Queues all the scripts with the .fal extension found in a directory.
+// Returns the count of queued scripts.
+int AutoloadScripts( const Falcon::String &dir, bool bShared = false );
+
+// Prints the scripts still being compiled.
+void ListPendingLoads();
+
+#endif
+
+/* end of fxchat_loader.h */
@@ -0,0 +1,254 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_mem.cpp
+
+   Falcon script Xchat plugin
+   Per VM memory accounting
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:51:21
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Per VM memory accounting.
+*/
+
+#include <falcon/engine.h>
+#include <falcon/memory.h>
+
+#include "fxchat_mem.h"
+
+#define MEM_MAGIC 0xFC3A11C5
+
+// Prefix of every accounted block; 16 bytes keep the alignment.
+struct MemHeader
+{
+   Falcon::uint32 m_magic;
+   Falcon::uint32 m_size;
+   MemAccount *m_owner;
+};
+
+static MemAccount s_engine( 0 );
+static __thread MemAccount *s_current = 0;
+static MemAccount *s_accounts = 0;
+static volatile long s_totalBytes = 0;
+
+// the engine allocators, to which we chain.
+static void *(*s_gcAlloc)( size_t ) = 0;
+static void (*s_gcFree)( void * ) = 0;
+static void *(*s_gcRealloc)( void *, size_t ) = 0;
+
+MemAccount::MemAccount( Falcon::VMachine *vm ):
+   m_vm( vm ),
+   m_bytes( 0 ),
+   m_blocks( 0 ),
+   m_collected( 0 ),
+   m_peak( 0 ),
+   m_limit( 0 ),
+   m_bOverLimit( false ),
+   m_refs( 1 ),
+   m_gcCycles( 0 ),
+   m_gcPause( 0 ),
+   m_gcMaxPause( 0 ),
+   m_gcMark( 0 )
+{
+   m_prevAcc = 0;
+   m_nextAcc = 0;
+
+   if ( vm != 0 )
+   {
+      m_nextAcc = s_accounts;
+      if ( s_accounts != 0 )
+         s_accounts->m_prevAcc = this;
+      s_accounts = this;
+   }
+}
+
+void MemAccount::release()
+{
+   if ( m_prevAcc != 0 )
+      m_prevAcc->m_nextAcc = m_nextAcc;
+   else
+      s_accounts = m_nextAcc;
+   if ( m_nextAcc != 0 )
+      m_nextAcc->m_prevAcc = m_prevAcc;
+
+   m_vm = 0;
+   decref();
+}
+
+void MemAccount::decref()
+{
+   // the engine account is never released.
+   if ( __sync_sub_and_fetch( &m_refs, 1 ) == 0 )
+      delete this;
+}
+
+void MemAccount::internal_alloc( long size )
+{
+   __sync_add_and_fetch( &m_refs, 1 );
+   __sync_add_and_fetch( &m_blocks, 1 );
+   internal_resize( size );
+}
+
+void MemAccount::internal_resize( long delta )
+{
+   __sync_add_and_fetch( &s_totalBytes, delta );
+   long bytes = __sync_add_and_fetch( &m_bytes, delta );
+
+   if ( bytes > m_peak )
+      m_peak = bytes;
+
+   // can't throw from inside the engine; the VM stops at the next instruction.
+   if ( m_limit != 0 && bytes > m_limit && ! m_bOverLimit && m_vm != 0 )
+   {
+      m_bOverLimit = true;
+      m_vm->breakRequest( true );
+   }
+}
+
+void MemAccount::chargeCollection( long usecs )
+{
+   ++m_gcCycles;
+   m_gcPause += usecs;
+   if ( usecs > m_gcMaxPause )
+      m_gcMaxPause = usecs;
+}
+
+void MemAccount::internal_free( long size )
+{
+   __sync_sub_and_fetch( &s_totalBytes, size );
+   __sync_sub_and_fetch( &m_bytes, size );
+   __sync_add_and_fetch( &m_collected, 1 );
+   __sync_sub_and_fetch( &m_blocks, 1 );
+   decref();
+}
+
+//==============================================
+// Allocators
+//
+
+static void *acc_gcAlloc( size_t size )
+{
+   MemHeader *hdr = (MemHeader *) s_gcAlloc( size + sizeof( MemHeader ) );
+   if ( hdr == 0 )
+      return 0;
+
+   hdr->m_magic = MEM_MAGIC;
+   hdr->m_size = (Falcon::uint32) size;
+   hdr->m_owner = s_current != 0 ? s_current : &s_engine;
+   hdr->m_owner->internal_alloc( size );
+   return hdr + 1;
+}
+
+static void acc_gcFree( void *mem )
+{
+   if ( mem == 0 )
+      return;
+
+   // we are installed before the engine allocates anything.
+   MemHeader *hdr = ((MemHeader *) mem) - 1;
+   fassert( hdr->m_magic == MEM_MAGIC );
+
+   hdr->m_magic = 0;
+   hdr->m_owner->internal_free( hdr->m_size );
+   s_gcFree( hdr );
+}
+
+static void *acc_gcRealloc( void *mem, size_t size )
+{
+   if ( mem == 0 )
+      return acc_gcAlloc( size );
+
+   if ( size == 0 )
+   {
+      acc_gcFree( mem );
+      return 0;
+   }
+
+   MemHeader *hdr = ((MemHeader *) mem) - 1;
+   fassert( hdr->m_magic == MEM_MAGIC );
+
+   // the block stays with its owner.
+   MemAccount *owner = hdr->m_owner;
+   long oldSize = hdr->m_size;
+   hdr = (MemHeader *) s_gcRealloc( hdr, size + sizeof( MemHeader ) );
+   if ( hdr == 0 )
+      return 0;
+
+   hdr->m_size = (Falcon::uint32) size;
+   owner->internal_resize( (long) size - oldSize );
+   return hdr + 1;
+}
+
+void InitMemAccounting()
+{
+   if ( s_gcAlloc != 0 )
+      return;
+
+   s_gcAlloc = Falcon::gcAlloc;
+   s_gcFree = Falcon::gcFree;
+   s_gcRealloc = Falcon::gcRealloc;
+
+   Falcon::gcAlloc = acc_gcAlloc;
+   Falcon::gcFree = acc_gcFree;
+   Falcon::gcRealloc = acc_gcRealloc;
+}
+
+void ShutdownMemAccounting()
+{
+   if ( s_gcAlloc == 0 )
+      return;
+
+   Falcon::gcAlloc = s_gcAlloc;
+   Falcon::gcFree = s_gcFree;
+   Falcon::gcRealloc = s_gcRealloc;
+   s_gcAlloc = 0;
+}
+
+const MemAccount *EngineMemAccount()
+{
+   return &s_engine;
+}
+
+MemAccount *FirstMemAccount()
+{
+   return s_accounts;
+}
+
+long TotalGCBytes()
+{
+   return s_totalBytes;
+}
+
+//==============================================
+// Scope
+//
+
+MemScope::MemScope( MemAccount *acc ):
+   m_prev( s_current )
+{
+   s_current = acc;
+}
+
+MemScope::~MemScope()
+{
+   s_current = m_prev;
+}
+
+Falcon::Error *HeapLimitError( const MemAccount *acc )
+{
+   Falcon::String desc = "heap limit of ";
+   desc.writeNumber( (Falcon::int64) acc->limit() / 1024 );
+   desc += " KB exceeded";
+
+   return new Falcon::GenericError( Falcon::ErrorParam( Falcon::e_inv_params, __LINE__ ).extra( desc ) );
+}
+
+/* end of fxchat_mem.cpp */
@@ -0,0 +1,128 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_mem.h
+
+   Falcon script Xchat plugin
+   Per VM memory accounting
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:51:21
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Per VM memory accounting.
+*/
+
+#ifndef fxchat_mem_H
+#define fxchat_mem_H
+
+#include <falcon/engine.h>
+
+// The engine garbage collected memory is allocated through replaceable
+// functions; we wrap them so that each block records the account of
+// the VM that was running when it was allocated. Blocks may be freed
+// in any thread, so the counters are updated atomically.
+
+class MemAccount
+{
+   Falcon::VMachine *m_vm;
+
+   // list of the accounts of the living VMs; main thread only.
+   MemAccount *m_nextAcc;
+   MemAccount *m_prevAcc;
+
+   volatile long m_bytes;
+   volatile long m_blocks;
+   volatile long m_collected;
+   long m_peak;
+   long m_limit;
+   bool m_bOverLimit;
+
+   // live blocks, plus one while the VM exists; the account is deleted
+   // by whoever takes it to zero.
+   volatile long m_refs;
+
+   void decref();
+
+   // collections, and the part of their pauses charged to this VM.
+   long m_gcCycles;
+   long m_gcPause;
+   long m_gcMaxPause;
+   long m_gcMark;
+
+public:
+   MemAccount( Falcon::VMachine *vm );
+
+   // Called in place of the destructor when the VM goes; the account is
+   // deleted when its last block is freed.
+   void release();
+
+   long bytes() const { return m_bytes; }
+   long blocks() const { return m_blocks; }
+   long collected() const { return m_collected; }
+   long peak() const { return m_peak; }
+   Falcon::VMachine *vm() const { return m_vm; }
+
+   long gcCycles() const { return m_gcCycles; }
+   long gcPause() const { return m_gcPause; }
+   long gcMaxPause() const { return m_gcMaxPause; }
+
+   // Called around a collection: remembers the collected blocks, then
+   // charges the pause in microsecs in proportion to the blocks collected.
+   void markCollection() { m_gcMark = m_collected; }
+   long collectedSinceMark() const { return m_collected - m_gcMark; }
+   void chargeCollection( long usecs );
+
+   MemAccount *nextAccount() const { return m_nextAcc; }
+
+   // Heap limit in bytes; 0 for none.
+   long limit() const { return m_limit; }
+   void limit( long l ) { m_limit = l; }
+
+   // true when the heap grew past the limit; the VM is asked to stop.
+   bool overLimit() const { return m_bOverLimit; }
+   void clearOverLimit() { m_bOverLimit = false; }
+
+   void internal_alloc( long size );
+   void internal_free( long size );
+   void internal_resize( long delta );
+};
+
+// Account receiving the allocations of this thread, while it exists.
+class MemScope
+{
+   MemAccount *m_prev;
+
+public:
+   MemScope( MemAccount *acc );
+   ~MemScope();
+};
+
+// Installs the accounting allocators; must be called before the
+// engine allocates anything, as every block freed is expected to have
+// the accounting header.
+void InitMemAccounting();
+// Restores the engine allocators, after the engine shutdown.
+void ShutdownMemAccounting();
+
+// Allocations made outside any VM.
+const MemAccount *EngineMemAccount();
+
+// The accounts of the existing VMs.
+MemAccount *FirstMemAccount();
+
+// Garbage collected bytes, VM or not.
+long TotalGCBytes();
+
+// Error raised by a VM over its heap limit.
+Falcon::Error *HeapLimitError( const MemAccount *acc );
+
+#endif
+
+/* end of fxchat_mem.h */
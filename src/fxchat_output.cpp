@@ -0,0 +1,106 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_output.cpp
+
+   Falcon script Xchat plugin
+   Coalesced script output
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 15:00:03
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Coalesced script output.
+*/
+
+#include <falcon/engine.h>
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "fxchat.h"
+#include "fxchat_output.h"
+#include "fxchat_context.h"
+
+// a long report is printed in pieces of about this size.
+#define OUTPUT_FLUSH_SIZE  (32*1024)
+
+static char *s_buffer = 0;
+static Falcon::uint32 s_length = 0;
+static Falcon::uint32 s_allocated = 0;
+
+// context of the queued text
+static xchat_context *s_context = 0;
+
+static int s_bursts = 0;
+
+void QueueOutput( const char *text, Falcon::uint32 size )
+{
+   xchat_context *ctx = CurrentContext();
+   if ( s_length != 0 && ctx != s_context )
+      FlushOutput();
+   s_context = ctx;
+
+   // one more for the terminator.
+   if ( s_length + size + 1 > s_allocated )
+   {
+      Falcon::uint32 alloc = s_allocated == 0 ? 1024 : s_allocated * 2;
+      while( alloc < s_length + size + 1 )
+         alloc *= 2;
+
+      s_buffer = (char *) realloc( s_buffer, alloc );
+      s_allocated = alloc;
+   }
+
+   memcpy( s_buffer + s_length, text, size );
+   s_length += size;
+}
+
+void CommitOutput()
+{
+   if ( s_bursts == 0 || s_length >= OUTPUT_FLUSH_SIZE )
+      FlushOutput();
+}
+
+void FlushOutput()
+{
+   if ( s_length == 0 )
+      return;
+
+   // xchat splits the text in lines on its own.
+   s_buffer[ s_length ] = 0;
+   s_length = 0;
+
+   // if the context has been closed meanwhile, print in the current one.
+   xchat_context *oldCtx = CurrentContext();
+   SwitchContext( s_context );
+   xchat_print( the_plugin, s_buffer );
+   SwitchContext( oldCtx );
+}
+
+void ShutdownOutput()
+{
+   FlushOutput();
+   free( s_buffer );
+   s_buffer = 0;
+   s_allocated = 0;
+}
+
+OutputBurst::OutputBurst()
+{
+   ++s_bursts;
+}
+
+OutputBurst::~OutputBurst()
+{
+   if ( --s_bursts == 0 )
+      FlushOutput();
+}
+
+/* end of fxchat_output.cpp */
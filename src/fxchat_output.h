@@ -0,0 +1,56 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_output.h
+
+   Falcon script Xchat plugin
+   Coalesced script output
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 15:00:03
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Coalesced script output.
+*/
+
+#ifndef fxchat_output_H
+#define fxchat_output_H
+
+#include <falcon/engine.h>
+
+// Each xchat_print redraws the text widget; the lines printed by the
+// scripts during a callback or a run are then kept aside and printed
+// together when it ends. The pending text belongs to the context that
+// was current when it was written; writing in another context, or
+// doing anything else that may print (commands, events, plugin
+// messages) flushes it first, so the order of the output is kept.
+
+// Appends utf-8 text to the output of the current context.
+void QueueOutput( const char *text, Falcon::uint32 size );
+
+// Prints the queued output, unless a burst is in progress.
+void CommitOutput();
+
+// Prints the queued output now.
+void FlushOutput();
+
+// Flushes and frees the output buffer.
+void ShutdownOutput();
+
+// Keeps the output queued while a script runs; can be nested.
+class OutputBurst
+{
+public:
+   OutputBurst();
+   ~OutputBurst();
+};
+
+#endif
+
+/* end of fxchat_output.h */
@@ -0,0 +1,73 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_prefix.cpp
+
+   Falcon script Xchat plugin
+   Parser for the prefix of IRC messages
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:36:07
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Parser for the prefix of IRC messages.
+*/
+
+#include "fxchat_prefix.h"
+#include "fxchat.h"
+
+void IrcPrefix::parse( const char *source )
+{
+   if ( *source == ':' )
+      ++source;
+
+   m_user = m_userEnd = 0;
+   m_host = m_hostEnd = 0;
+
+   // the nick ends at the first "!" or "@"
+   const char *p = source;
+   while( *p != '\0' && *p != ' ' && *p != '!' && *p != '@' )
+      ++p;
+
+   m_nick = source;
+   m_nickEnd = p;
+
+   if ( *p == '!' )
+   {
+      m_user = ++p;
+      while( *p != '\0' && *p != ' ' && *p != '@' )
+         ++p;
+      m_userEnd = p;
+   }
+
+   if ( *p == '@' )
+   {
+      m_host = ++p;
+      while( *p != '\0' && *p != ' ' )
+         ++p;
+      m_hostEnd = p;
+   }
+}
+
+Falcon::CoreString *IrcPrefix::nickString() const
+{
+   return UTF8Slice( m_nick, m_nickEnd );
+}
+
+Falcon::CoreString *IrcPrefix::userString() const
+{
+   return UTF8Slice( m_user, m_userEnd );
+}
+
+Falcon::CoreString *IrcPrefix::hostString() const
+{
+   return UTF8Slice( m_host, m_hostEnd );
+}
+
+/* end of fxchat_prefix.cpp */
@@ -0,0 +1,71 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_prefix.h
+
+   Falcon script Xchat plugin
+   Parser for the prefix of IRC messages
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:36:07
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Parser for the prefix of IRC messages.
+*/
+
+#ifndef fxchat_prefix_H
+#define fxchat_prefix_H
+
+#include <falcon/engine.h>
+
+// The sender of an IRC message, nick[!user][@host], split in place.
+// Parts are slices of the original buffer; the ones that are missing
+// are zero. Server names are returned as a nick without user and host.
+class IrcPrefix
+{
+   const char *m_nick;
+   const char *m_nickEnd;
+   const char *m_user;
+   const char *m_userEnd;
+   const char *m_host;
+   const char *m_hostEnd;
+
+public:
+   IrcPrefix():
+      m_nick( 0 ), m_nickEnd( 0 ),
+      m_user( 0 ), m_userEnd( 0 ),
+      m_host( 0 ), m_hostEnd( 0 )
+   {}
+
+   explicit IrcPrefix( const char *source ) { parse( source ); }
+
+   // Scans the source once, skipping a leading ":" and stopping at the first blank.
+   void parse( const char *source );
+
+   // true if the prefix is a user rather than a server.
+   bool isUser() const { return m_user != 0 || m_host != 0; }
+   bool hasUser() const { return m_user != 0; }
+   bool hasHost() const { return m_host != 0; }
+
+   const char *nick() const { return m_nick; }
+   const char *nickEnd() const { return m_nickEnd; }
+   const char *user() const { return m_user; }
+   const char *userEnd() const { return m_userEnd; }
+   const char *host() const { return m_host; }
+   const char *hostEnd() const { return m_hostEnd; }
+
+   // Decode the parts in new strings.
+   Falcon::CoreString *nickString() const;
+   Falcon::CoreString *userString() const;
+   Falcon::CoreString *hostString() const;
+};
+
+#endif
+
+/* end of fxchat_prefix.h */
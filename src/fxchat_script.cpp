@@ -22,24 +22,41 @@
 #include "fxchat_script.h"
 #include "fxchat_errhand.h"
 #include "fxchat_hook.h"
+#include "fxchat_dispatch.h"
 #include "fxchat_vm.h"
+#include "fxchat_gc.h"
+#include "fxchat_output.h"
 #include "fxchat.h"
 
 #include <stdio.h>
 
-ScriptData::ScriptData( Falcon::Module *mod, char **params ):
+extern "C" int mod_sleep_timer_cb( void *user_data );
+
+ScriptData::ScriptData( Falcon::Module *mod, char **params, bool bShared ):
    m_module( mod ),
-   m_vm( new XChatVM( this ) ),
+   m_mainLive( 0 ),
+   m_vm( bShared ? XChatVM::takeShared() : XChatVM::takePrelinked() ),
    m_next( 0 ),
    m_prev( 0 ),
    m_bStatus( true ),
-   m_pSleepHook( 0 )
+   m_sleepTimer( mod_sleep_timer_cb, this ),
+   m_name( mod->name() ),
+   m_generation( 0 ),
+   m_budget( DEFAULT_BUDGET_MSECS ),
+   m_overruns( 0 ),
+   m_preemptions( 0 )
 {
    m_module->incref();
+   m_name.bufferize();
+   MemScope scope( m_vm->memAccount() );
 
-   // insert the standard modules in the VM
-   m_vm->link( s_modCore );
-   m_liveModule = m_vm->link( s_modXchat );
+   // the standard modules and the keys are already in the VM.
+   if ( bShared )
+      m_vm->scriptData( this );
+   else
+      m_vm->owner( this );
+   m_liveModule = m_vm->xchatModule();
+   m_ctxClass = m_liveModule->findModuleItem( "XChatContext" );
 
    // We'll add the args that the user wants to provide us.
    Falcon::Item *item = m_vm->findGlobalItem( "args" );
@@ -51,8 +68,8 @@ ScriptData::ScriptData( Falcon::Module *mod, char **params ):
       {
          while( *params != 0 && **params != '\0' )
          {
-            args->append( Falcon::UTF8String( *params ) );
-            ++args;
+            args->append( FastUTF8String( *params ) );
+            ++params;
          }
       }
    }
@@ -79,10 +96,36 @@ ScriptData::~ScriptData()
 {
 	delete m_hook_lock;
    m_module->decref();
+
+   if ( m_vm->isShared() )
+   {
+      if ( m_vm->scriptData() == this )
+         m_vm->scriptData( 0 );
+      XChatVM::releaseShared();
+      return;
+   }
+
+   m_vm->destroyKeys();
    // this will also destroy the core array used for hooks.
    m_vm->finalize();
 }
 
+void ScriptData::link( Falcon::Runtime *rt )
+{
+   MemScope scope( m_vm->memAccount() );
+
+   // in a shared VM, an unloaded script with the same name may be still there.
+   if ( m_vm->findModule( m_module->name() ) != 0 )
+   {
+      Falcon::String genName = m_name + "#";
+      genName.writeNumber( (Falcon::int64) ++m_generation );
+      m_module->name( genName );
+   }
+
+   m_vm->link( rt );
+   m_mainLive = m_vm->findModule( m_module->name() );
+}
+
 void ScriptData::insertAfter( ScriptData *prev )
 {
    m_next = prev->m_next;
@@ -110,23 +153,34 @@ void ScriptData::remove()
    m_prev = m_next = 0;
 }
 
+// Detaches the hook from xchat and voids the script object.
+static void internal_release( Falcon::CoreObject *hook )
+{
+   XChatHook *xh = (XChatHook *) hook->getUserData();
+
+   // the hook may have already dis-hooked itself.
+   if ( xh != 0 )
+   {
+      if ( xh->dispatched() )
+         UnsubscribeServer( xh );
+      else if ( xh->timer() != 0 )
+         xh->timer()->cancel();
+      else
+         xchat_unhook( the_plugin, xh->hook() );
+
+      // void the hook
+      hook->setUserData( (Falcon::FalconData*)0 );
+      delete xh;
+   }
+}
+
 void ScriptData::unhookAll()
 {
    cancelSleep();
 
    for( int i = 0; i < m_hooks->length(); i++ )
    {
-      Falcon::CoreObject *hook = m_hooks->at( i ).asObject();
-      XChatHook *xh = (XChatHook *) hook->getUserData();
-
-      // the hook may have already dis-hooked itself.
-      if ( xh != 0 )
-      {
-         xchat_unhook( the_plugin, xh->hook() );
-         // void the hook
-         hook->setUserData( (Falcon::FalconData*)0 );
-         delete xh;
-      }
+      internal_release( m_hooks->at( i ).asObject() );
    }
 
    // empty the array of hooks
@@ -147,50 +201,62 @@ extern "C" int mod_sleep_timer_cb( void *user_data )
    {
       XChatErrHand::handleError( err, mod );
    }
+
+   // a new sleep re-arms the timer; mod may be gone by now.
+   return 0;
 }
 
 
 void ScriptData::putAtSleep( Falcon::numeric seconds )
 {
-   if( m_pSleepHook != 0 )
-   {
-      xchat_unhook( the_plugin, m_pSleepHook );
-   }
-
-   int slt = (int)(seconds*1000);
-   m_pSleepHook = xchat_hook_timer( the_plugin, slt, mod_sleep_timer_cb, this );
-
+   m_sleepTimer.start( (Falcon::int64)(seconds*1000) );
 }
 
 void ScriptData::cancelSleep()
 {
-   if ( m_pSleepHook != 0 )
-   {
-      xchat_unhook( the_plugin, m_pSleepHook );
-      m_pSleepHook = 0;
-   }
+   m_sleepTimer.cancel();
 }
 
 
 void ScriptData::RunVM( bool reset )
 {
+   MemScope scope( m_vm->memAccount() );
+   OutputBurst burst;
+   NoteScriptActivity();
+   if ( ! m_vm->isShared() )
+      m_vm->startSlice();
+
    if ( reset )
    {
       // restart from beginning of the program
-      if ( m_vm->mainModule()->module()->findGlobalSymbol( "__main__" ) == 0 )
+      if ( m_module->findGlobalSymbol( "__main__" ) == 0 )
       {
-         Falcon::AutoCString name( m_module->name() );
+         Falcon::AutoCString name( m_name );
          xchat_printf( the_plugin, PNAME ": the module %s has no main routine and cannot be launched\n",
             name.c_str() );
          return;
       }
-      
-      m_vm->launch();
+
+      if ( m_vm->isShared() )
+      {
+         // the VM main module is the one of another script.
+         m_vm->scriptData( this );
+         m_vm->startSlice();
+         m_vm->callItem( *m_mainLive->findModuleItem( "__main__" ), 0 );
+      }
+      else
+         m_vm->launch();
    }
    else
       m_vm->run();
 
    // in case of error, the callers must catch us.
+   if ( m_vm->memAccount()->overLimit() )
+   {
+      cancelSleep();
+      m_vm->memAccount()->clearOverLimit();
+      throw HeapLimitError( m_vm->memAccount() );
+   }
 
    if ( ! isSleeping() )
    {
@@ -217,13 +283,110 @@ void ScriptData::removeHook( Falcon::CoreObject *hook )
       if ( m_hooks->at(i).asObject() == hook )
       {
          m_hooks->remove( i );
-         // no need to destroy anything: the GC will rip it at good time.
-         // it will rip also the internal data, that is, the XChatHook
+         // the xchat side must go now; shared server hooks would
+         // otherwise keep calling a hook that the GC may destroy.
+         internal_release( hook );
          break;
       }
    }
 }
 
+//===========================================================
+// Hot reload
+//
+
+void ScriptData::hotReload( Falcon::Module *mod, Falcon::Runtime *rt )
+{
+   MemScope scope( m_vm->memAccount() );
+
+   Falcon::LiveModule *oldLive = m_mainLive;
+
+   // the VM knows its modules by name; the new version lives beside the old one.
+   Falcon::String genName = m_name + "#";
+   genName.writeNumber( (Falcon::int64) ++m_generation );
+   mod->name( genName );
+   mod->path( m_module->path() );
+
+   m_vm->link( rt );
+   Falcon::LiveModule *newLive = m_vm->findModule( genName );
+   m_mainLive = newLive;
+
+   internal_migrate( oldLive, newLive );
+   internal_rebind( newLive );
+
+   mod->incref();
+   m_module->decref();
+   m_module = mod;
+
+   // the main code is not run again; the script can fix its state here.
+   Falcon::Item *reload = newLive->findModuleItem( "__reload__" );
+   if ( reload != 0 && reload->isCallable() )
+   {
+      Falcon::CoreDict *old = new Falcon::CoreDict( new Falcon::LinearDict );
+      Falcon::MapIterator iter = oldLive->module()->symbolTable().map().begin();
+      while( iter.hasCurrent() )
+      {
+         Falcon::Symbol *sym = *(Falcon::Symbol **) iter.currentValue();
+         Falcon::Item *value;
+         if ( sym->isGlobal() && ( value = oldLive->findModuleItem( sym->name() ) ) != 0 )
+            old->put( new Falcon::CoreString( sym->name() ), *value );
+         iter.next();
+      }
+
+      m_vm->scriptData( this );
+      m_vm->pushParameter( old );
+      m_vm->callItem( *reload, 1 );
+   }
+}
+
+// Copies the variables of the old version in the ones with the same name.
+void ScriptData::internal_migrate( Falcon::LiveModule *oldLive, Falcon::LiveModule *newLive )
+{
+   Falcon::MapIterator iter = m_module->symbolTable().map().begin();
+   while( iter.hasCurrent() )
+   {
+      Falcon::Symbol *sym = *(Falcon::Symbol **) iter.currentValue();
+      iter.next();
+
+      // functions and classes come from the new code.
+      if ( ! sym->isGlobal() )
+         continue;
+
+      Falcon::Item *oldValue = oldLive->findModuleItem( sym->name() );
+      Falcon::Item *newValue = newLive->findModuleItem( sym->name() );
+      if ( oldValue != 0 && newValue != 0 )
+         *newValue = *oldValue;
+   }
+}
+
+// Points the callbacks to the functions with the same name in the new version.
+void ScriptData::internal_rebind( Falcon::LiveModule *newLive )
+{
+   for( Falcon::uint32 i = 0; i < m_hooks->length(); i++ )
+   {
+      Falcon::CoreObject *hook = m_hooks->at( i ).asObject();
+      Falcon::Item i_callback;
+      if ( ! hook->getProperty( "callback", i_callback ) )
+         continue;
+
+      // in sigmas, the function is the first element.
+      Falcon::Item *func = &i_callback;
+      if ( i_callback.isArray() && i_callback.asArray()->length() > 0 )
+         func = &i_callback.asArray()->at( 0 );
+
+      // methods are bound to objects, and they stay with them.
+      if ( ! func->isFunction() )
+         continue;
+
+      Falcon::Item *newFunc = newLive->findModuleItem( func->asFunction()->name() );
+      if ( newFunc != 0 && newFunc->isFunction() )
+      {
+         *func = *newFunc;
+         hook->setProperty( "callback", i_callback );
+      }
+   }
+}
+
 //===========================================================
 // Module list
 //
@@ -262,7 +425,7 @@ ScriptData *ScriptDataList::find( const Falcon::String &name )
    ScriptData *p = m_head;
    while( p != 0 )
    {
-      if ( p->m_module->name() == name )
+      if ( p->name() == name )
          return p;
 
       p = p->m_next;
@@ -310,14 +473,19 @@ void ScriptDataList::list()
    }
 
    xchat_print( the_plugin,
-      PNAME ": Status  Name\n"
-      PNAME ": ------  ----------------------------------\n" );
+      PNAME ": Status  Heap KB  Peak KB  Name\n"
+      PNAME ": ------  -------  -------  -------------------------\n" );
 
    ScriptData *mod = m_head;
    while( mod != 0 )
    {
-      Falcon::String status = mod->m_bStatus ? "Ok  " : "Error";
-      xchat_print_falcon( PNAME ": "+ status + "    " + mod->m_module->name() +"\n" );
+      const MemAccount *acc = mod->m_vm->memAccount();
+      char mem[32];
+      snprintf( mem, sizeof( mem ), "%7ld  %7ld  ", acc->bytes() / 1024, acc->peak() / 1024 );
+
+      Falcon::String status = mod->m_bStatus ? "Ok      " : "Error   ";
+      xchat_print_falcon( PNAME ": "+ status + mem + mod->name() +
+            ( mod->m_vm->isShared() ? " (shared)\n" : "\n" ) );
       mod = mod->m_next;
    }
    xchat_print( the_plugin, PNAME ": ----------------------------------------------\n" );
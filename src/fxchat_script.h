@@ -24,10 +24,17 @@
 
 #include <falcon/engine.h>
 #include "xchat-plugin.h"
+#include "fxchat_timer.h"
 
 class ScriptDataList;
 class XChatVM;
 
+// Default execution budget of a callback or of a run of a script, in msecs;
+// 0 means none, and scripts are given one through /FALCON BUDGET.
+#define DEFAULT_BUDGET_MSECS 0
+// VM instructions between two checks of the budget.
+#define SLICE_CHECK_LOOPS 5000
+
 // The main structure holding our modules.
 class ScriptData
 {
@@ -39,10 +46,10 @@ class ScriptData
 
    friend class ScriptDataList;
 
-   // This is the sleep/vm yield timeout callback.
+   // This is the sleep/vm yield timeout.
    // it is managed transparently with respect to the VM, so we may have
-   // just an xchat_hook for it.
-   xchat_hook *m_pSleepHook;
+   // just a timer for it.
+   TimerEntry m_sleepTimer;
 
    // This is the list of hooks that the script has registered.
    // As the regitered hooks, on the script standpoint, are VM items,
@@ -56,31 +63,61 @@ class ScriptData
    // destruction.
    Falcon::CoreArray *m_hooks;
 	Falcon::GarbageLock *m_hook_lock;
-	
-   
+
+   // The name of the script; the module changes name on hot reloads.
+   Falcon::String m_name;
+   int m_generation;
+
+   // execution budget in msecs, 0 for none, and how often it was exceeded.
+   int m_budget;
+   long m_overruns;
+   long m_preemptions;
+
+   void internal_migrate( Falcon::LiveModule *oldLive, Falcon::LiveModule *newLive );
+   void internal_rebind( Falcon::LiveModule *newLive );
+
 public:
    Falcon::Module *m_module;
    // Pre-cached live-module pointer
    Falcon::LiveModule *m_liveModule;
+   // Pre-cached XChatContext class item
+   Falcon::Item *m_ctxClass;
+   // Live module of the script itself
+   Falcon::LiveModule *m_mainLive;
 
    XChatVM *m_vm;
 
    bool m_bStatus;
 
-   ScriptData( Falcon::Module *mod, char **args );
+   // Shared scripts are loaded in the VM common to all of them.
+   ScriptData( Falcon::Module *mod, char **args, bool bShared = false );
    ~ScriptData();
 
+   // Links the compiled script in the VM. MAY THROW.
+   void link( Falcon::Runtime *rt );
+
    void addHook( Falcon::CoreObject *hook );
    void removeHook( Falcon::CoreObject *hook );
    void unhookAll();
    void putAtSleep( Falcon::numeric seconds );
    void cancelSleep();
-   bool isSleeping() const { return m_pSleepHook != 0; }
+   bool isSleeping() const { return m_sleepTimer.armed(); }
 
    // MAY THROW, check out for errors.
    void RunVM( bool reset = false );
 
-   const Falcon::String &name() const { return m_module->name(); }
+   // Links a new version of the script in the running VM, keeping its
+   // globals and hooks. MAY THROW, check out for errors.
+   void hotReload( Falcon::Module *mod, Falcon::Runtime *rt );
+
+   int budget() const { return m_budget; }
+   void budget( int msecs ) { m_budget = msecs; }
+   // Records a budget overrun; preempted unless the VM can't be suspended.
+   void overrun( bool preempted ) { ++m_overruns; if ( preempted ) ++m_preemptions; }
+   long overruns() const { return m_overruns; }
+   long preemptions() const { return m_preemptions; }
+
+   const Falcon::String &name() const { return m_name; }
    Falcon::CoreArray *hooks() const { return m_hooks; }
 };
 
@@ -21,72 +21,129 @@
 
 #include "fxchat_stream.h"
 #include "fxchat.h"
+#include "fxchat_output.h"
 
 #include <string.h>
+#include <stdlib.h>
 
 XChatStream::XChatStream():
-   m_prefix( "" ),
-   Stream( t_stream )
+   Stream( t_stream ),
+   m_prefix( 0 ),
+   m_prefixLen( 0 ),
+   m_buffer( 0 ),
+   m_length( 0 ),
+   m_allocated( 0 )
 {
 }
 
 XChatStream::XChatStream( const Falcon::String &prefix ):
-	m_prefix( prefix ),
-	Stream( t_stream )
+	Stream( t_stream ),
+	m_prefix( 0 ),
+	m_prefixLen( 0 ),
+	m_buffer( 0 ),
+	m_length( 0 ),
+	m_allocated( 0 )
 {
+	this->prefix( prefix );
 }
 
-Falcon::int32 XChatStream::write( const void *buffer, Falcon::int32 size )
+XChatStream::~XChatStream()
 {
-	const char *buf = (const char *)buffer;
-	int len = 0;
-	while( len < size )
-	{
-		len ++;
-		m_buffer += *buf;
-		if ( *buf == '\n' )
-		{
-			xchat_print_falcon( m_prefix + m_buffer );
-			m_buffer = "";
-      }
-		++buf;
-   }
+	free( m_prefix );
+	free( m_buffer );
 }
 
+void XChatStream::prefix( const Falcon::String &p )
+{
+	Falcon::uint32 size = p.length() * 4 + 1; // max utf8 size
+	m_prefix = (char *) realloc( m_prefix, size );
+	p.toCString( m_prefix, size );
+	m_prefixLen = strlen( m_prefix );
+}
+
+void XChatStream::reserve( Falcon::uint32 size )
+{
+	if ( size <= m_allocated )
+		return;
+
+	Falcon::uint32 alloc = m_allocated == 0 ? 256 : m_allocated * 2;
+	while( alloc < size )
+		alloc *= 2;
+
+	m_buffer = (char *) realloc( m_buffer, alloc );
+	m_allocated = alloc;
+}
+
+Falcon::int32 XChatStream::write( const void *buffer, Falcon::int32 size )
+{
+	if ( size <= 0 )
+		return 0;
+
+	internalWrite( (const char *) buffer, size );
+	return size;
+}
 
 
 bool XChatStream::writeString( const Falcon::String &source, Falcon::uint32 begin, Falcon::uint32 end )
 {
-	if ( begin != 0 || end <= source.length() )
+	if ( end > source.length() )
+		end = source.length();
+	if ( begin >= end )
+		return true;
+
+	// convert directly at the end of the pending text.
+	Falcon::uint32 size = ( end - begin ) * 4 + 1; // max utf8 size
+	reserve( m_length + size );
+
+	char *target = m_buffer + m_length;
+	if ( begin != 0 || end != source.length() )
 	{
 		Falcon::String sub( source, begin, end );
-		internalWrite( sub );
+		sub.toCString( target, size );
 	}
 	else {
-		internalWrite( source );
+		source.toCString( target, size );
 	}
 
+	Falcon::uint32 len = strlen( target );
+	// the text is already in place.
+	m_length += len;
+	if ( memchr( target, '\n', len ) != 0 )
+		printLines();
+
 	return true;
 }
 
-void XChatStream::internalWrite( const Falcon::String &source )
+void XChatStream::internalWrite( const char *data, Falcon::uint32 size )
 {
-	Falcon::uint32 pos = source.find( "\n" );
-	if ( pos != Falcon::csh::npos )
-   {
-      if ( pos == source.length() - 1 )
-      {
-         xchat_print_falcon( m_prefix + m_buffer + source );
-         m_buffer = "";
-      }
-      else {
-         xchat_print_falcon( m_prefix + m_buffer + source.subString( 0, pos + 1 ) );
-         m_buffer = source.subString( pos + 1 );
-      }
-   }
-   else {
-      m_buffer += source;
-   }
+	reserve( m_length + size );
+	memcpy( m_buffer + m_length, data, size );
+	m_length += size;
+
+	if ( memchr( data, '\n', size ) != 0 )
+		printLines();
+}
+
+// Sends all the complete lines to xchat, and keeps the rest.
+void XChatStream::printLines()
+{
+	const char *pos = m_buffer;
+	const char *end = m_buffer + m_length;
+	const char *eol;
+
+	while( ( eol = (const char *) memchr( pos, '\n', end - pos ) ) != 0 )
+	{
+		if ( m_prefixLen != 0 )
+			QueueOutput( m_prefix, m_prefixLen );
+		QueueOutput( pos, eol - pos + 1 );
+		pos = eol + 1;
+	}
+
+	m_length = end - pos;
+	memmove( m_buffer, pos, m_length );
+
+	// printed at the end of the running callback.
+	CommitOutput();
 }
 
 Falcon::int64 XChatStream::seek( Falcon::int64 pos, e_whence w )
@@ -142,12 +199,38 @@ bool XChatStream::get( Falcon::uint32 &chr )
 
 bool XChatStream::put( Falcon::uint32 chr )
 {
-	m_buffer += chr;
-	if( chr == '\n' )
+	// utf-8 encoding of a single character
+	char utf8[4];
+	Falcon::uint32 size;
+
+	if ( chr < 0x80 )
+	{
+		utf8[0] = (char) chr;
+		size = 1;
+	}
+	else if ( chr < 0x800 )
+	{
+		utf8[0] = (char) ( 0xC0 | ( chr >> 6 ) );
+		utf8[1] = (char) ( 0x80 | ( chr & 0x3F ) );
+		size = 2;
+	}
+	else if ( chr < 0x10000 )
+	{
+		utf8[0] = (char) ( 0xE0 | ( chr >> 12 ) );
+		utf8[1] = (char) ( 0x80 | ( ( chr >> 6 ) & 0x3F ) );
+		utf8[2] = (char) ( 0x80 | ( chr & 0x3F ) );
+		size = 3;
+	}
+	else
 	{
-		xchat_print_falcon( m_prefix + m_buffer );
-		m_buffer = "";
+		utf8[0] = (char) ( 0xF0 | ( ( chr >> 18 ) & 0x07 ) );
+		utf8[1] = (char) ( 0x80 | ( ( chr >> 12 ) & 0x3F ) );
+		utf8[2] = (char) ( 0x80 | ( ( chr >> 6 ) & 0x3F ) );
+		utf8[3] = (char) ( 0x80 | ( chr & 0x3F ) );
+		size = 4;
 	}
+
+	internalWrite( utf8, size );
 	return true;
 }
 
@@ -25,12 +25,24 @@
 #include <falcon/engine.h>
 #include <falcon/stream.h>
 
+// Output stream of the scripts; complete lines are printed in xchat.
+// The text is kept as utf-8 in a growable byte buffer, so that each
+// chunk written is converted once and scanned for line ends in bulk.
 class XChatStream: public Falcon::Stream
 {
-	Falcon::String m_prefix;
-	Falcon::String m_buffer;
+	// utf-8 text printed before each line
+	char *m_prefix;
+	Falcon::uint32 m_prefixLen;
 
-	void internalWrite( const Falcon::String &source );
+	// pending utf-8 text; only the last line can be incomplete.
+	char *m_buffer;
+	Falcon::uint32 m_length;
+	Falcon::uint32 m_allocated;
+
+	void reserve( Falcon::uint32 size );
+	// Appends utf-8 text, printing the lines it completes.
+	void internalWrite( const char *data, Falcon::uint32 size );
+	void printLines();
 
 protected:
 	virtual Falcon::int64 seek( Falcon::int64 pos, e_whence w );
@@ -40,9 +52,13 @@ public:
 
    XChatStream();
 	XChatStream( const Falcon::String &prefix );
+	virtual ~XChatStream();
+
+	void prefix( const Falcon::String &p );
 
    virtual bool close();
    virtual Falcon::int32 read( void *buffer, Falcon::int32 size );
+   // the data is taken as utf-8 text.
    virtual Falcon::int32 write( const void *buffer, Falcon::int32 size );
    virtual Falcon::int64 tell();
    virtual bool truncate( Falcon::int64 pos=-1 );
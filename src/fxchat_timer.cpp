@@ -0,0 +1,368 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_timer.cpp
+
+   Falcon script Xchat plugin
+   Timer wheel
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:56:53
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Timer wheel.
+*/
+
+#include <falcon/engine.h>
+
+#include <time.h>
+
+#include "fxchat.h"
+#include "fxchat_timer.h"
+
+// Level 0 has 256 slots of one tick; the upper levels have 64 slots,
+// each one as wide as the whole level below.
+#define WHEEL_BITS0     8
+#define WHEEL_BITS      6
+#define WHEEL_LEVELS    4
+#define WHEEL_SIZE0     (1 << WHEEL_BITS0)
+#define WHEEL_SIZE      (1 << WHEEL_BITS)
+#define WHEEL_SPAN      ((Falcon::int64) 1 << (WHEEL_BITS0 + (WHEEL_LEVELS - 1) * WHEEL_BITS))
+
+// Circular list of entries, headed by a sentinel.
+class TimerList
+{
+public:
+   TimerEntry m_head;
+
+   TimerList():
+      m_head( 0, 0 )
+   {
+      m_head.m_next = m_head.m_prev = &m_head;
+   }
+
+   bool empty() const { return m_head.m_next == &m_head; }
+
+   void append( TimerEntry *t )
+   {
+      t->m_prev = m_head.m_prev;
+      t->m_next = &m_head;
+      m_head.m_prev->m_next = t;
+      m_head.m_prev = t;
+   }
+
+   // moves all the entries of this list in another one.
+   void spliceTo( TimerList &other )
+   {
+      if ( empty() )
+         return;
+
+      other.m_head.m_prev->m_next = m_head.m_next;
+      m_head.m_next->m_prev = other.m_head.m_prev;
+      m_head.m_prev->m_next = &other.m_head;
+      other.m_head.m_prev = m_head.m_prev;
+      m_head.m_next = m_head.m_prev = &m_head;
+   }
+};
+
+static TimerList s_wheel0[ WHEEL_SIZE0 ];
+static TimerList s_wheel[ WHEEL_LEVELS - 1 ][ WHEEL_SIZE ];
+static int s_levelCount[ WHEEL_LEVELS ];
+
+// last tick processed
+static Falcon::int64 s_tick = -1;
+
+// entries found due while catching up outside the driver; they are
+// fired by the next tick, not by the code arming a timer.
+static TimerList s_overdue;
+
+// the entry being fired, or 0 if it has been cancelled in its callback.
+static TimerEntry *s_firing = 0;
+
+static xchat_hook *s_driver = 0;
+static int s_driverMsecs = 0;
+static bool s_inDriver = false;
+
+extern "C" int timer_driver_cb( void *user_data );
+
+Falcon::int64 TimerNow()
+{
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return (Falcon::int64) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void internal_unlink( TimerEntry *t )
+{
+   t->m_prev->m_next = t->m_next;
+   t->m_next->m_prev = t->m_prev;
+   t->m_next = t->m_prev = t;
+}
+
+static void internal_timer_insert( TimerEntry *t )
+{
+   if ( s_tick < 0 )
+      s_tick = TimerNow() / TIMER_TICK_MSECS;
+
+   // rounded up: a timer is never early.
+   Falcon::int64 ticks = ( t->m_deadline + TIMER_TICK_MSECS - 1 ) / TIMER_TICK_MSECS;
+   if ( ticks <= s_tick )
+      ticks = s_tick + 1;
+
+   Falcon::int64 delta = ticks - s_tick;
+   if ( delta >= WHEEL_SPAN )
+      ticks = s_tick + WHEEL_SPAN - 1;  // cascaded again later
+
+   if ( delta < WHEEL_SIZE0 )
+   {
+      t->m_level = 0;
+      s_wheel0[ ticks & (WHEEL_SIZE0 - 1) ].append( t );
+   }
+   else
+   {
+      int level = 1;
+      int shift = WHEEL_BITS0;
+      while( level < WHEEL_LEVELS - 1 && delta >= ( (Falcon::int64) 1 << ( shift + WHEEL_BITS ) ) )
+      {
+         ++level;
+         shift += WHEEL_BITS;
+      }
+
+      t->m_level = level;
+      s_wheel[ level - 1 ][ ( ticks >> shift ) & (WHEEL_SIZE - 1) ].append( t );
+   }
+
+   ++s_levelCount[ t->m_level ];
+}
+
+static void internal_remove( TimerEntry *t )
+{
+   --s_levelCount[ t->m_level ];
+   t->m_level = -1;
+   internal_unlink( t );
+}
+
+// Puts the entries of an upper slot in the levels below.
+static void internal_cascade( TimerList &slot )
+{
+   TimerList moving;
+   slot.spliceTo( moving );
+
+   while( ! moving.empty() )
+   {
+      TimerEntry *t = moving.m_head.m_next;
+      internal_remove( t );
+      internal_timer_insert( t );
+   }
+}
+
+static void internal_timer_fire( TimerEntry *t, Falcon::int64 now )
+{
+   internal_remove( t );
+
+   s_firing = t;
+   int ret = t->m_cb( t->m_data );
+
+   // repeat, unless the timer was destroyed or re-armed by its callback.
+   if ( ret != 0 && s_firing == t && ! t->armed() )
+   {
+      t->m_deadline += t->m_interval;
+      if ( t->m_deadline <= now )
+         t->m_deadline = now + t->m_interval - ( now - t->m_deadline ) % t->m_interval;
+      internal_timer_insert( t );
+   }
+
+   s_firing = 0;
+}
+
+// Due entries are fired, or moved in the overdue list if defer is true.
+static void internal_advance( Falcon::int64 nowTick, Falcon::int64 now, bool defer = false )
+{
+   // after a long suspension, reschedule everything at once.
+   if ( nowTick - s_tick > WHEEL_SPAN )
+   {
+      TimerList all;
+      for( int i = 0; i < WHEEL_SIZE0; i++ )
+         s_wheel0[i].spliceTo( all );
+      for( int l = 0; l < WHEEL_LEVELS - 1; l++ )
+         for( int i = 0; i < WHEEL_SIZE; i++ )
+            s_wheel[l][i].spliceTo( all );
+
+      s_tick = nowTick - 1;
+      internal_cascade( all );
+   }
+
+   while( s_tick < nowTick )
+   {
+      ++s_tick;
+
+      // refill the levels below when they complete a round.
+      int shift = WHEEL_BITS0;
+      for( int level = 1; level < WHEEL_LEVELS; level++ )
+      {
+         if ( ( s_tick & ( ( (Falcon::int64) 1 << shift ) - 1 ) ) != 0 )
+            break;
+         internal_cascade( s_wheel[ level - 1 ][ ( s_tick >> shift ) & (WHEEL_SIZE - 1) ] );
+         shift += WHEEL_BITS;
+      }
+
+      TimerList &slot = s_wheel0[ s_tick & (WHEEL_SIZE0 - 1) ];
+      if ( slot.empty() )
+         continue;
+
+      if ( defer )
+      {
+         // they stay in level 0, so they can still be cancelled.
+         slot.spliceTo( s_overdue );
+         continue;
+      }
+
+      // callbacks may add or cancel timers; fire from a private list.
+      TimerList due;
+      slot.spliceTo( due );
+      while( ! due.empty() )
+         internal_timer_fire( due.m_head.m_next, now );
+   }
+}
+
+// Keeps the driver running at tick rate only when level 0 has entries;
+// otherwise, it runs once per round of level 0.
+static void internal_arm_driver()
+{
+   int msecs = 0;
+   if ( s_levelCount[0] > 0 )
+      msecs = TIMER_TICK_MSECS;
+   else
+   {
+      for( int level = 1; level < WHEEL_LEVELS; level++ )
+      {
+         if ( s_levelCount[level] > 0 )
+         {
+            // wake up when the next upper slot is due to be cascaded.
+            msecs = TIMER_TICK_MSECS * ( WHEEL_SIZE0 - (int) ( s_tick & (WHEEL_SIZE0 - 1) ) );
+            break;
+         }
+      }
+   }
+
+   if ( msecs == s_driverMsecs )
+      return;
+
+   // the driver callback removes itself by returning 0.
+   if ( s_driver != 0 && ! s_inDriver )
+      xchat_unhook( the_plugin, s_driver );
+
+   s_driverMsecs = msecs;
+   s_driver = msecs != 0 ? xchat_hook_timer( the_plugin, msecs, timer_driver_cb, 0 ) : 0;
+}
+
+// Brings the wheel to the current time when the driver isn't ticking,
+// so that new timers are placed by their real distance.
+static void internal_catch_up()
+{
+   if ( s_tick < 0 || s_inDriver || s_driverMsecs == TIMER_TICK_MSECS )
+      return;
+
+   Falcon::int64 nowTick = TimerNow() / TIMER_TICK_MSECS;
+   if ( nowTick <= s_tick )
+      return;
+
+   bool empty = true;
+   for( int level = 0; level < WHEEL_LEVELS; level++ )
+   {
+      if ( s_levelCount[level] > 0 )
+      {
+         empty = false;
+         break;
+      }
+   }
+
+   // the driver was stopped; there's nothing to walk through.
+   if ( empty )
+      s_tick = nowTick;
+   else
+      internal_advance( nowTick, 0, true );
+}
+
+extern "C" int timer_driver_cb( void *user_data )
+{
+   Falcon::int64 now = TimerNow();
+   xchat_hook *self = s_driver;
+
+   s_inDriver = true;
+   while( ! s_overdue.empty() )
+      internal_timer_fire( s_overdue.m_head.m_next, now );
+   internal_advance( now / TIMER_TICK_MSECS, now );
+   internal_arm_driver();
+   s_inDriver = false;
+
+   return s_driver == self ? 1 : 0;
+}
+
+//==============================================
+// Timer entry
+//
+
+TimerEntry::TimerEntry( TimerCallback cb, void *data ):
+   m_next( this ),
+   m_prev( this ),
+   m_cb( cb ),
+   m_data( data ),
+   m_deadline( 0 ),
+   m_interval( 0 ),
+   m_level( -1 )
+{
+}
+
+TimerEntry::~TimerEntry()
+{
+   cancel();
+}
+
+void TimerEntry::start( Falcon::int64 msecs )
+{
+   if ( armed() )
+      internal_remove( this );
+
+   if ( msecs < 0 )
+      msecs = 0;
+
+   internal_catch_up();
+
+   m_interval = msecs > 0 ? msecs : 1;
+   m_deadline = TimerNow() + msecs;
+   internal_timer_insert( this );
+
+   if ( ! s_inDriver )
+      internal_arm_driver();
+}
+
+void TimerEntry::cancel()
+{
+   if ( s_firing == this )
+      s_firing = 0;
+
+   if ( armed() )
+   {
+      internal_remove( this );
+      if ( ! s_inDriver )
+         internal_arm_driver();
+   }
+}
+
+void ShutdownTimers()
+{
+   if ( s_driver != 0 && ! s_inDriver )
+      xchat_unhook( the_plugin, s_driver );
+
+   s_driver = 0;
+   s_driverMsecs = 0;
+}
+
+/* end of fxchat_timer.cpp */
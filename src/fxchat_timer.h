@@ -0,0 +1,74 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_timer.h
+
+   Falcon script Xchat plugin
+   Timer wheel
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:56:53
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Timer wheel.
+*/
+
+#ifndef fxchat_timer_H
+#define fxchat_timer_H
+
+#include <falcon/engine.h>
+
+// All the script timers (sleeps and timer hooks) live in a hierarchical
+// timer wheel, driven by a single xchat timer. Deadlines are rounded up
+// to the wheel tick, so close timers are fired together; insertion and
+// cancellation are O(1).
+//
+// As for xchat timers, a callback returning nonzero is called again
+// after the same interval; the next deadline is computed from the
+// previous one, so repeating timers don't drift.
+
+typedef int (*TimerCallback)( void *user_data );
+
+// Milliseconds of a wheel tick; the tolerance of the deadlines.
+#define TIMER_TICK_MSECS 10
+
+class TimerEntry
+{
+public:
+   // wheel data; managed by fxchat_timer.cpp only.
+   TimerEntry *m_next;
+   TimerEntry *m_prev;
+
+   TimerCallback m_cb;
+   void *m_data;
+   Falcon::int64 m_deadline;  // msecs on the monotonic clock
+   Falcon::int64 m_interval;
+   int m_level;               // -1 when not armed
+
+   TimerEntry( TimerCallback cb, void *data );
+   // a destroyed timer is cancelled.
+   ~TimerEntry();
+
+   // (Re)arms the timer after the given msecs.
+   void start( Falcon::int64 msecs );
+   void cancel();
+   bool armed() const { return m_level >= 0; }
+
+   Falcon::int64 deadline() const { return m_deadline; }
+};
+
+// Milliseconds on the monotonic clock.
+Falcon::int64 TimerNow();
+
+// Removes the driver timer from xchat; the entries are kept.
+void ShutdownTimers();
+
+#endif
+
+/* end of fxchat_timer.h */
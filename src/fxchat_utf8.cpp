@@ -0,0 +1,139 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_utf8.cpp
+
+   Falcon script Xchat plugin
+   Conversion of xchat utf-8 strings to Falcon strings
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:37:19
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin
+   Conversion of xchat utf-8 strings to Falcon strings.
+*/
+
+#include <falcon/engine.h>
+#include <falcon/mempool.h>
+
+#include <string.h>
+#include <stddef.h>
+
+#include "fxchat_utf8.h"
+
+// Words are checked with a mask: a byte with the high bit set
+// makes the word non ASCII.
+typedef unsigned long word_t;
+
+static const word_t ONES = ( (word_t) -1 ) / 0xFF;
+static const word_t HIGHS = ONES * 0x80;
+
+static inline bool internal_aligned( const char *p )
+{
+   return ( (size_t) p & ( sizeof( word_t ) - 1 ) ) == 0;
+}
+
+// Words are loaded through memcpy, which the compiler turns into a
+// single load, without breaking the aliasing rules.
+static inline word_t internal_load( const char *p )
+{
+   word_t w;
+   memcpy( &w, p, sizeof( word_t ) );
+   return w;
+}
+
+bool ScanASCII( const char *str, Falcon::uint32 &len )
+{
+   // the library strlen knows how to find the terminator without
+   // reading past the string; the bytes are then checked in bounds.
+   size_t size = strlen( str );
+   if ( ! IsASCII( str, str + size ) )
+      return false;
+
+   len = (Falcon::uint32) size;
+   return true;
+}
+
+bool IsASCII( const char *begin, const char *end )
+{
+   const char *p = begin;
+
+   while( p < end && ! internal_aligned( p ) )
+   {
+      if ( (*p & 0x80) != 0 )
+         return false;
+      ++p;
+   }
+
+   while( end - p >= (ptrdiff_t) sizeof( word_t ) )
+   {
+      if ( ( internal_load( p ) & HIGHS ) != 0 )
+         return false;
+      p += sizeof( word_t );
+   }
+
+   // the tail is shorter than a word.
+   while( p < end )
+   {
+      if ( (*p & 0x80) != 0 )
+         return false;
+      ++p;
+   }
+
+   return true;
+}
+
+// Copies ASCII bytes in a new string, with no decoding.
+static Falcon::CoreString *internal_ascii_string( const char *str, Falcon::uint32 len )
+{
+   Falcon::CoreString *cs = new Falcon::CoreString;
+   if ( len > 0 )
+   {
+      char *buffer = (char *) Falcon::memAlloc( len );
+      memcpy( buffer, str, len );
+      cs->adopt( buffer, len, len );
+   }
+
+   return cs;
+}
+
+Falcon::CoreString *FastUTF8String( const char *str )
+{
+   Falcon::uint32 len;
+   if ( ScanASCII( str, len ) )
+      return internal_ascii_string( str, len );
+
+   return Falcon::UTF8String( str );
+}
+
+Falcon::CoreString *UTF8Slice( const char *begin, const char *end )
+{
+   int len = end - begin;
+   if ( IsASCII( begin, end ) )
+      return internal_ascii_string( begin, len );
+
+   // try to do it the fast way using stack memory.
+   char buffer[512];
+
+   if ( len < 512 )
+   {
+      memcpy( buffer, begin, len );
+      buffer[len] = '\0';
+      return Falcon::UTF8String( buffer );
+   }
+
+   char *temp = new char[ len + 1 ];
+   memcpy( temp, begin, len );
+   temp[len] = '\0';
+   Falcon::CoreString *ret = Falcon::UTF8String( temp );
+   delete[] temp;
+   return ret;
+}
+
+/* end of fxchat_utf8.cpp */
@@ -0,0 +1,46 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: fxchat_utf8.h
+
+   Falcon script Xchat plugin
+   Conversion of xchat utf-8 strings to Falcon strings
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:37:19
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Falcon script Xchat plugin.
+   Conversion of xchat utf-8 strings to Falcon strings.
+*/
+
+#ifndef fxchat_utf8_H
+#define fxchat_utf8_H
+
+#include <falcon/engine.h>
+
+// Most of the IRC traffic is plain ASCII, which is valid utf-8 and
+// can be copied byte by byte in a Falcon string. These functions
+// check for bytes having the high bit set a machine word at a time,
+// and fall back to the utf-8 decoder only when they find one.
+
+// Creates a string out of a zero terminated utf-8 buffer.
+Falcon::CoreString *FastUTF8String( const char *str );
+
+// Creates a string out of a part of an utf-8 buffer.
+Falcon::CoreString *UTF8Slice( const char *begin, const char *end );
+
+// Returns true if the string is pure ASCII, filling its length.
+bool ScanASCII( const char *str, Falcon::uint32 &len );
+
+// Returns true if the buffer is pure ASCII.
+bool IsASCII( const char *begin, const char *end );
+
+#endif
+
+/* end of fxchat_utf8.h */
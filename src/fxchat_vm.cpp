@@ -22,22 +22,225 @@
 #include "fxchat_stream.h"
 #include "fxchat_vm.h"
 #include "fxchat_script.h"
+#include "fxchat_events.h"
+#include "fxchat.h"
+#include "fxchat_timer.h"
 
+// The VMs to be given to the next scripts, how many are wanted,
+// and the timer preparing them.
+static XChatVM *s_spares[ MAX_SPARE_VMS ];
+static int s_spareCount = 0;
+static int s_spareWanted = 1;
+static xchat_hook *s_spareTimer = 0;
 
-XChatVM::XChatVM( ScriptData *owner ):
+// The VM of the lightweight scripts, and how many scripts are in it.
+static XChatVM *s_shared = 0;
+static int s_sharedUsers = 0;
+
+extern "C" int spare_timer_cb( void *user_data )
+{
+   // one VM per idle time, so that xchat gets its turn in between.
+   if ( s_spareCount < s_spareWanted )
+      s_spares[ s_spareCount++ ] = new XChatVM;
+
+   if ( s_spareCount < s_spareWanted )
+      return 1;
+
+   s_spareTimer = 0;
+   return 0;
+}
+
+static void slice_check_cb( Falcon::VMachine *vm )
+{
+   static_cast<XChatVM *>( vm )->checkSlice();
+}
+
+XChatVM::XChatVM():
    VMachine( false ),  // prevent initialization of streams.
-   m_scriptData( owner )
+   m_scriptData( 0 ),
+   m_bShared( false ),
+   m_mem( new MemAccount( this ) ),
+   m_sliceEnd( 0 ),
+   m_noBreak( 0 ),
+   m_keys( 0 ),
+   m_keyLock( 0 )
 {
+   MemScope scope( m_mem );
+
    m_stdOut = new XChatStream();
-   m_stdErr = new XChatStream( owner->name() + ": " );
+   m_stdErr = new XChatStream();
    init();
+
+   // insert the standard modules in the VM
+   link( s_modCore );
+   m_xchatModule = link( s_modXchat );
+
+   // prepare the keys used by the event dictionaries
+   createKeys();
+
+   // the clock is read every few thousands of instructions.
+   periodicCallback( slice_check_cb );
+   callbackLoops( SLICE_CHECK_LOOPS );
+}
+
+XChatVM::~XChatVM()
+{
+   // the blocks still alive will be freed later by the collector.
+   m_mem->release();
+}
+
+XChatVM *XChatVM::takePrelinked()
+{
+   XChatVM *vm;
+   if ( s_spareCount > 0 )
+      vm = s_spares[ --s_spareCount ];
+   else
+      vm = new XChatVM;
+
+   // this script was one of those waiting for a VM.
+   if ( s_spareWanted > 1 )
+      --s_spareWanted;
+
+   // prepare the next one when xchat is idle, not now.
+   preparePrelinked();
+   return vm;
+}
+
+void XChatVM::preparePrelinked( int count )
+{
+   if ( count > MAX_SPARE_VMS )
+      count = MAX_SPARE_VMS;
+   if ( count > s_spareWanted )
+      s_spareWanted = count;
+
+   if ( s_spareCount < s_spareWanted && s_spareTimer == 0 )
+      s_spareTimer = xchat_hook_timer( the_plugin, 0, spare_timer_cb, 0 );
+}
+
+void XChatVM::dropPrelinked()
+{
+   if ( s_spareTimer != 0 )
+   {
+      xchat_unhook( the_plugin, s_spareTimer );
+      s_spareTimer = 0;
+   }
+
+   while( s_spareCount > 0 )
+   {
+      XChatVM *vm = s_spares[ --s_spareCount ];
+      vm->destroyKeys();
+      vm->finalize();
+   }
+   s_spareWanted = 1;
+}
+
+XChatVM *XChatVM::takeShared()
+{
+   if ( s_shared == 0 )
+   {
+      s_shared = new XChatVM;
+      s_shared->m_bShared = true;
+      // until a script runs in it.
+      static_cast<XChatStream *>( s_shared->m_stdErr )->prefix( "shared: " );
+   }
+
+   ++s_sharedUsers;
+   return s_shared;
+}
+
+void XChatVM::releaseShared()
+{
+   // the modules of the unloaded scripts go with the VM.
+   if ( --s_sharedUsers == 0 )
+   {
+      s_shared->destroyKeys();
+      s_shared->finalize();
+      s_shared = 0;
+   }
+}
+
+void XChatVM::owner( ScriptData *owner )
+{
+   m_scriptData = owner;
+   static_cast<XChatStream *>( m_stdErr )->prefix( owner->name() + ": " );
+}
+
+void XChatVM::scriptData( ScriptData *sd )
+{
+   if ( sd == m_scriptData )
+      return;
+
+   m_scriptData = sd;
+   if ( m_bShared && sd != 0 )
+      static_cast<XChatStream *>( m_stdErr )->prefix( sd->name() + ": " );
 }
 
 void XChatVM::onIdleTime( Falcon::numeric seconds )
 {
+   // suspending the VM would suspend all the scripts in it.
+   if ( m_bShared )
+   {
+      throw new Falcon::GenericError( Falcon::ErrorParam( Falcon::e_inv_params, __LINE__ )
+            .extra( "sleep() is not available to shared scripts" ) );
+   }
+
+   // the native call would be resumed past its end.
+   if ( m_noBreak != 0 )
+   {
+      throw new Falcon::GenericError( Falcon::ErrorParam( Falcon::e_inv_params, __LINE__ )
+            .extra( "sleep() is not available inside a context run" ) );
+   }
+
    scriptData()->putAtSleep( seconds );
    breakRequest(true);
 }
 
+void XChatVM::startSlice()
+{
+   int budget = scriptData()->budget();
+   m_sliceEnd = budget > 0 ? TimerNow() + budget : 0;
+}
+
+void XChatVM::checkSlice()
+{
+   if ( m_sliceEnd == 0 || TimerNow() < m_sliceEnd )
+      return;
+
+   // once per slice.
+   m_sliceEnd = 0;
+
+   // suspending the VM would suspend all the scripts in it, or
+   // a native call that must be completed.
+   if ( ! canBreak() )
+   {
+      scriptData()->overrun( false );
+      return;
+   }
+
+   // continue as soon as xchat has had its turn.
+   scriptData()->overrun( true );
+   scriptData()->putAtSleep( 0 );
+   breakRequest(true);
+}
+
+void XChatVM::createKeys()
+{
+   int count = ParamKeyCount();
+   m_keys = new Falcon::CoreArray( count );
+
+   for( int i = 0; i < count; i++ )
+   {
+      m_keys->append( new Falcon::CoreString( ParamKeyName( i ) ) );
+   }
+
+   m_keyLock = new Falcon::GarbageLock( Falcon::Item( m_keys ) );
+}
+
+void XChatVM::destroyKeys()
+{
+   delete m_keyLock;
+   m_keyLock = 0;
+}
+
 
 /* end of fxchat_vm.cpp */
@@ -23,22 +23,95 @@
 #define fxchat_vm_H
 
 #include <falcon/engine.h>
+#include "fxchat_mem.h"
+#include "fxchat_context.h"
+
+// Most VMs prepared in advance for the scripts being loaded.
+#define MAX_SPARE_VMS 16
 
 // The specific xchat vmachine sets up standard streams and
 // provides a back-link to the owner script data.
+//
+// A VM is created with the standard modules already linked; to take
+// that cost out of the script loading, spare VMs are prepared in
+// advance, one per script waiting to be loaded, and handed to the
+// next scripts.
+//
+// Lightweight scripts can also share a single VM; in that case the
+// script data is the one of the script currently running in the VM.
+//
+// Each callback and each run of the script is a slice of execution,
+// limited by the budget of the script; a script exceeding it is
+// suspended, and resumed from the timer wheel.
 
 class ScriptData;
 
 class XChatVM: public Falcon::VMachine
 {
    ScriptData *m_scriptData;
+   Falcon::LiveModule *m_xchatModule;
+   bool m_bShared;
+   MemAccount *m_mem;
+
+   // end of the current execution slice on the monotonic clock; 0 if none.
+   Falcon::int64 m_sliceEnd;
+   // nesting of the native calls that can't be left suspended.
+   int m_noBreak;
+
+   // Key atoms used as keys of the event dictionaries; they are
+   // created once per VM and kept alive through a gc lock.
+   Falcon::CoreArray *m_keys;
+   Falcon::GarbageLock *m_keyLock;
+
+   // XChatContext instances already given to the scripts.
+   ContextCache m_contexts;
+
 public:
-   XChatVM( ScriptData *owner );
+   XChatVM();
+   virtual ~XChatVM();
+
+   // Schedules the creation of spare VMs at the next idle times, until
+   // there are at least count of them (up to MAX_SPARE_VMS).
+   static void preparePrelinked( int count = 1 );
+   // Returns a spare VM, or a new one, and prepares the next spare.
+   static XChatVM *takePrelinked();
+   // Destroys the spare VMs; to be called before the engine shutdown.
+   static void dropPrelinked();
+
+   // Returns the VM shared by the lightweight scripts, creating it if needed.
+   static XChatVM *takeShared();
+   // Releases a script's reference to the shared VM.
+   static void releaseShared();
+
+   // Assigns the VM to its script.
+   void owner( ScriptData *owner );
+   bool isShared() const { return m_bShared; }
+   MemAccount *memAccount() const { return m_mem; }
 
    // Override idle time requests.
    virtual void onIdleTime( Falcon::numeric seconds );
+
+   // Starts a slice with the budget of the running script.
+   void startSlice();
+   // Called periodically by the VM loop; preempts the script out of budget.
+   void checkSlice();
+   // Brackets native calls that must run to completion, as ctx.run()
+   // that must restore the context when the call returns.
+   void enterNoBreak() { ++m_noBreak; }
+   void leaveNoBreak() { --m_noBreak; }
+   bool canBreak() const { return ! m_bShared && m_noBreak == 0; }
    
    ScriptData *scriptData() const { return m_scriptData; }
+   // Sets the script running in a shared VM, and the prefix of its errors.
+   void scriptData( ScriptData *sd );
+   Falcon::LiveModule *xchatModule() const { return m_xchatModule; }
+
+   void createKeys();
+   // must be called before finalize()
+   void destroyKeys();
+   Falcon::String *key( int id ) const { return m_keys->at( id ).asString(); }
+
+   ContextCache &contexts() { return m_contexts; }
 };
 
 
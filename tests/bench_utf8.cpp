@@ -0,0 +1,134 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: bench_utf8.cpp
+
+   Falcon script Xchat plugin
+   Microbenchmark of the utf-8 to Falcon string conversion
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:37:19
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Microbenchmark of the utf-8 to Falcon string conversion.
+
+   Usage: bench_utf8 [capture file] [rounds]
+
+   The capture file holds one raw IRC line per line (i.e. a raw log of
+   a busy server); every word of every line is converted, as the server
+   hooks do. Without a capture, a small built-in sample is used.
+*/
+
+#include <falcon/engine.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <vector>
+#include <string>
+
+#include "../src/fxchat_utf8.h"
+
+static const char *s_sample[] = {
+   ":jonnymind!~jm@example.com PRIVMSG #falcon :hello everybody, how is it going?",
+   ":nick!user@host.example.net JOIN :#falcon",
+   ":irc.example.net 353 me = #falcon :@jonnymind +voiced nick other another",
+   ":irc.example.net 352 me #falcon ~user host.example.net irc.example.net nick H :0 Real Name",
+   ":someone!~s@10.0.0.1 PRIVMSG #falcon :perch\xc3\xa9 non funziona pi\xc3\xb9?",
+   ":other!o@host PART #falcon :Leaving",
+   0
+};
+
+static double now()
+{
+   struct timeval tv;
+   gettimeofday( &tv, 0 );
+   return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// splits the lines in words, as xchat does.
+static void split( const std::string &line, std::vector<std::string> &words )
+{
+   size_t pos = 0;
+   while( pos < line.size() )
+   {
+      size_t end = line.find( ' ', pos );
+      if ( end == std::string::npos )
+         end = line.size();
+      if ( end > pos )
+         words.push_back( line.substr( pos, end - pos ) );
+      pos = end + 1;
+   }
+}
+
+int main( int argc, char *argv[] )
+{
+   Falcon::Engine::Init();
+
+   std::vector<std::string> words;
+   if ( argc > 1 )
+   {
+      FILE *fp = fopen( argv[1], "r" );
+      if ( fp == 0 )
+      {
+         fprintf( stderr, "Can't open %s\n", argv[1] );
+         return 1;
+      }
+
+      char line[4096];
+      while( fgets( line, sizeof( line ), fp ) != 0 )
+      {
+         line[ strcspn( line, "\r\n" ) ] = '\0';
+         split( line, words );
+      }
+      fclose( fp );
+   }
+   else {
+      for( int i = 0; s_sample[i] != 0; i++ )
+         split( s_sample[i], words );
+   }
+
+   int rounds = argc > 2 ? atoi( argv[2] ) : 10000;
+
+   int ascii = 0;
+   for( size_t i = 0; i < words.size(); i++ )
+   {
+      Falcon::uint32 len;
+      if ( ScanASCII( words[i].c_str(), len ) )
+         ++ascii;
+   }
+
+   printf( "%d words, %d%% ASCII, %d rounds\n", (int) words.size(),
+         words.empty() ? 0 : (int) ( ascii * 100 / words.size() ), rounds );
+
+   double start = now();
+   for( int r = 0; r < rounds; r++ )
+   {
+      for( size_t i = 0; i < words.size(); i++ )
+         Falcon::UTF8String( words[i].c_str() );
+   }
+   double decoder = now() - start;
+
+   start = now();
+   for( int r = 0; r < rounds; r++ )
+   {
+      for( size_t i = 0; i < words.size(); i++ )
+         FastUTF8String( words[i].c_str() );
+   }
+   double fast = now() - start;
+
+   double count = (double) rounds * words.size();
+   printf( "UTF8String:     %8.3f s  %8.1f ns/word\n", decoder, decoder * 1e9 / count );
+   printf( "FastUTF8String: %8.3f s  %8.1f ns/word\n", fast, fast * 1e9 / count );
+
+   Falcon::Engine::Shutdown();
+   return 0;
+}
+
+/* end of bench_utf8.cpp */
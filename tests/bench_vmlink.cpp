@@ -0,0 +1,177 @@
+/*
+   FALCON - The Falcon Programming Language.
+   FILE: bench_vmlink.cpp
+
+   Falcon script Xchat plugin
+   Microbenchmark of the script VM setup
+   -------------------------------------------------------------------
+   Author: agent
+   Begin: 2026-10-17 14:45:47
+
+   -------------------------------------------------------------------
+   (C) Copyright 2004: the FALCON developers (see list in AUTHORS file)
+
+   See LICENSE file for licensing details.
+*/
+
+/** \file
+   Microbenchmark of the script VM setup.
+
+   Compares the time spent on the loading path by a burst of scripts
+   (as the autoload at startup) when each of them builds its XChatVM,
+   with the core and xchat modules and the event keys, and when it
+   takes one of the VMs prepared in advance with XChatVM::takePrelinked().
+   In both cases the script module is then linked in the VM.
+
+   The plugin objects are linked in; the few xchat calls on this path
+   are answered by a fake timer loop standing for the xchat idle times,
+   whose cost is reported apart, as it's out of the loading path.
+
+   Usage: bench_vmlink <script.fal> [scripts]
+*/
+
+#include <falcon/engine.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "../src/fxchat.h"
+#include "../src/fxchat_ext.h"
+#include "../src/fxchat_mem.h"
+#include "../src/fxchat_vm.h"
+
+//==============================================
+// Fake xchat timers; a single one is enough here.
+//
+
+static int (*s_timerCb)( void * ) = 0;
+static void *s_timerData = 0;
+
+extern "C" xchat_hook *xchat_hook_timer( xchat_plugin *ph, int timeout,
+      int (*callback) (void *user_data), void *userdata )
+{
+   s_timerCb = callback;
+   s_timerData = userdata;
+   return (xchat_hook *) &s_timerCb;
+}
+
+extern "C" void *xchat_unhook( xchat_plugin *ph, xchat_hook *hook )
+{
+   void *data = s_timerData;
+   s_timerCb = 0;
+   s_timerData = 0;
+   return data;
+}
+
+// Runs the timer until it's removed, as xchat would do when idle.
+static void run_idle()
+{
+   while( s_timerCb != 0 )
+   {
+      int (*cb)( void * ) = s_timerCb;
+      if ( cb( s_timerData ) == 0 && s_timerCb == cb )
+         s_timerCb = 0;
+   }
+}
+
+static double now_usecs()
+{
+   struct timeval tv;
+   gettimeofday( &tv, 0 );
+   return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static void destroy_vms( XChatVM **vms, int count )
+{
+   for( int i = 0; i < count; i++ )
+   {
+      vms[i]->destroyKeys();
+      vms[i]->finalize();
+   }
+}
+
+int main( int argc, char *argv[] )
+{
+   if ( argc < 2 )
+   {
+      fprintf( stderr, "Usage: bench_vmlink <script.fal> [scripts]\n" );
+      return 1;
+   }
+
+   int count = argc > 2 ? atoi( argv[2] ) : 8;
+   if ( count <= 0 )
+      count = 8;
+
+   // same order as the plugin init.
+   InitMemAccounting();
+   Falcon::Engine::Init();
+   s_modCore = Falcon::core_module_init();
+   s_modXchat = Falcon::create_xchat_module();
+   {
+      Falcon::ModuleLoader loader( "." );
+      Falcon::Module *mod = 0;
+
+      try
+      {
+         mod = loader.loadSource( argv[1] );
+         Falcon::Runtime rt( &loader );
+         rt.addModule( mod );
+
+         XChatVM **vms = new XChatVM*[ count ];
+
+         // a new VM for each script
+         double start = now_usecs();
+         for( int i = 0; i < count; i++ )
+         {
+            vms[i] = new XChatVM;
+            vms[i]->link( &rt );
+         }
+         double fresh = ( now_usecs() - start ) / count;
+         destroy_vms( vms, count );
+
+         // the VMs are prepared while the scripts are compiled.
+         start = now_usecs();
+         XChatVM::preparePrelinked( count );
+         run_idle();
+         double idle = ( now_usecs() - start ) / count;
+
+         start = now_usecs();
+         for( int i = 0; i < count; i++ )
+         {
+            vms[i] = XChatVM::takePrelinked();
+            vms[i]->link( &rt );
+         }
+         double prelinked = ( now_usecs() - start ) / count;
+         destroy_vms( vms, count );
+         delete[] vms;
+
+         run_idle();
+         XChatVM::dropPrelinked();
+
+         printf( "scripts:   %d (at most %d VMs prepared)\n", count, MAX_SPARE_VMS );
+         printf( "fresh:     %.1f usecs per script\n", fresh );
+         printf( "prelinked: %.1f usecs per script\n", prelinked );
+         printf( "idle time: %.1f usecs per prepared VM\n", idle );
+      }
+      catch( Falcon::Error *err )
+      {
+         Falcon::String desc;
+         err->toString( desc );
+         Falcon::AutoCString cdesc( desc );
+         fprintf( stderr, "%s\n", cdesc.c_str() );
+         err->decref();
+      }
+
+      if ( mod != 0 )
+         mod->decref();
+   }
+   s_modCore->decref();
+   s_modXchat->decref();
+   Falcon::Engine::Shutdown();
+   ShutdownMemAccounting();
+
+   return 0;
+}
+
+/* end of bench_vmlink.cpp */